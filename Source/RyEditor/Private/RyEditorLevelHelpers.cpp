@@ -6,6 +6,7 @@
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "Kismet2/KismetEditorUtilities.h"
 #include "RyEditorModule.h"
+#include "UObject/UObjectHash.h"
 
 //---------------------------------------------------------------------------------------------------------------------
 /**
@@ -95,3 +96,107 @@ UActorComponent* URyEditorLevelHelpers::CreateComponentForActor(AActor *owner, T
 
     return NewInstanceComponent;
 }
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyEditorLevelHelpers::CreateComponentsForActor(AActor *owner, const TArray<FRyComponentCreationRequest>& requests, TArray<UActorComponent*>& componentsOut)
+{
+    componentsOut.Reset(requests.Num());
+    if(!owner)
+        return;
+
+    owner->Modify();
+
+    // Names already taken under the owner, gathered once instead of a find per candidate name
+    TSet<FName> UsedNames;
+    {
+        TArray<UObject*> OwnedObjects;
+        GetObjectsWithOuter(owner, OwnedObjects, false);
+        UsedNames.Reserve(OwnedObjects.Num() + requests.Num());
+        for(const UObject* OwnedObject : OwnedObjects)
+        {
+            UsedNames.Add(OwnedObject->GetFName());
+        }
+    }
+
+    // Next numerical suffix to try per type name, so each name search starts where the last one ended
+    TMap<FString, int32> NextSuffixes;
+
+    TInlineComponentArray<UActorComponent*> PreInstanceComponents;
+    owner->GetComponents(PreInstanceComponents);
+
+    for(const FRyComponentCreationRequest& Request : requests)
+    {
+        if(!Request.ComponentClass)
+        {
+            componentsOut.Add(nullptr);
+            continue;
+        }
+
+        // Same naming as CreateComponentForActor
+        FString ComponentTypeName = FBlueprintEditorUtils::GetClassNameWithoutSuffix(Request.ComponentClass);
+        FString SuffixToStrip(TEXT("Component"));
+        if(ComponentTypeName.EndsWith(SuffixToStrip))
+        {
+            ComponentTypeName = ComponentTypeName.Left(ComponentTypeName.Len() - SuffixToStrip.Len());
+        }
+
+        int32& Counter = NextSuffixes.FindOrAdd(ComponentTypeName, 1);
+        FName NewComponentName = *ComponentTypeName;
+        while(UsedNames.Contains(NewComponentName))
+        {
+            NewComponentName = *FString::Printf(TEXT("%s%d"), *ComponentTypeName, Counter++);
+        }
+        UsedNames.Add(NewComponentName);
+
+        UActorComponent* NewInstanceComponent = NewObject<UActorComponent>(owner, Request.ComponentClass, NewComponentName, RF_Transactional);
+        if(USceneComponent* NewSceneComponent = Cast<USceneComponent>(NewInstanceComponent))
+        {
+            USceneComponent* AttachComponent = Request.AttachParent;
+            if(componentsOut.IsValidIndex(Request.AttachParentIndex))
+            {
+                AttachComponent = Cast<USceneComponent>(componentsOut[Request.AttachParentIndex]);
+            }
+            if(!AttachComponent)
+            {
+                AttachComponent = owner->GetRootComponent();
+            }
+
+            if(AttachComponent)
+            {
+                NewSceneComponent->AttachToComponent(AttachComponent, FAttachmentTransformRules::SnapToTargetIncludingScale);
+            }
+            else
+            {
+                owner->SetRootComponent(NewSceneComponent);
+            }
+        }
+
+        owner->AddInstanceComponent(NewInstanceComponent);
+        NewInstanceComponent->OnComponentCreated();
+        componentsOut.Add(NewInstanceComponent);
+    }
+
+    // Register the new components together, then any components they created without registering
+    for(UActorComponent* NewInstanceComponent : componentsOut)
+    {
+        if(NewInstanceComponent && !NewInstanceComponent->IsRegistered())
+        {
+            NewInstanceComponent->RegisterComponent();
+        }
+    }
+
+    TInlineComponentArray<UActorComponent*> PostInstanceComponents;
+    owner->GetComponents(PostInstanceComponents);
+    for(UActorComponent* ActorComponent : PostInstanceComponents)
+    {
+        if(!ActorComponent->IsRegistered() && ActorComponent->bAutoRegister && !ActorComponent->IsPendingKill() && !PreInstanceComponents.Contains(ActorComponent))
+        {
+            ActorComponent->RegisterComponent();
+        }
+    }
+
+    // Rerun construction scripts, once for the whole batch
+    owner->RerunConstructionScripts();
+}
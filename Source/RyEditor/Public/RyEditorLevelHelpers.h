@@ -7,6 +7,24 @@
 
 #include "RyEditorLevelHelpers.generated.h"
 
+// One component for CreateComponentsForActor to create
+USTRUCT(BlueprintType)
+struct RYEDITOR_API FRyComponentCreationRequest
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RyEditor|LevelHelpers")
+    TSubclassOf<UActorComponent> ComponentClass;
+
+    // Scene component to attach to. If null (and AttachParentIndex isn't set) attaches to the owner's root.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RyEditor|LevelHelpers")
+    USceneComponent* AttachParent = nullptr;
+
+    // Index of an earlier request in the same batch whose component to attach to. Overrides AttachParent.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RyEditor|LevelHelpers")
+    int32 AttachParentIndex = INDEX_NONE;
+};
+
 //---------------------------------------------------------------------------------------------------------------------
 /**
   * Static Helper functions related to editor levels
@@ -21,4 +39,10 @@ public:
     // A Helper function to create a component of a class type and attach it to the actor
     UFUNCTION(BlueprintCallable, CallInEditor, Category = "RyEditor|LevelHelpers")
     static UActorComponent* CreateComponentForActor(AActor *owner, TSubclassOf<UActorComponent> newComponentClass, USceneComponent *attachComponent = nullptr);
+
+    // Create many components on an actor at once. Like CreateComponentForActor, but unique names are worked out from one scan
+    // of the actor, all components are registered together, and construction scripts are rerun once at the end.
+    // componentsOut is aligned to requests, with nullptr for requests without a valid class.
+    UFUNCTION(BlueprintCallable, CallInEditor, Category = "RyEditor|LevelHelpers")
+    static void CreateComponentsForActor(AActor *owner, const TArray<FRyComponentCreationRequest>& requests, TArray<UActorComponent*>& componentsOut);
 };
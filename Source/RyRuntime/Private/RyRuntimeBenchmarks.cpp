@@ -0,0 +1,500 @@
+// Copyright 2020-2021 Sheffer Online Services.
+// MIT License. See LICENSE for details.
+
+// Microbenchmarks for the RyRuntime helpers, registered as the Ry.Benchmarks automation test (performance filter).
+// Headless example (Linux):
+//   UE4Editor-Cmd MyProject.uproject -unattended -nullrhi -nosplash -ExecCmds="Automation RunTests Ry.Benchmarks;Quit"
+// Optional command line switches: -RyBenchmarkFilter=<substring> -RyBenchmarkMinMs=<milliseconds per benchmark>
+// -RyBenchmarkTolerance=<fraction> -RyBenchmarkSaveBaseline
+//
+// Each benchmark reports nanoseconds per op and the process memory growth over one pass, and is compared against
+// Saved/RyRuntime/Benchmarks/Baseline.csv. Time regressions beyond the tolerance fail the test.
+// Correctness of the same helpers is covered by the Ry.Runtime tests in RyRuntimeTests.cpp.
+
+#include "RyRuntimeModule.h"
+#include "RyRuntimeMathHelpers.h"
+#include "RyRuntimeBitsetHelpers.h"
+#include "RyRuntimeComponentHelpers.h"
+#include "RyRuntimeStringHelpers.h"
+#include "RyRuntimeObjectHelpers.h"
+#include "Components/SceneComponent.h"
+#include "Components/SplineComponent.h"
+#include "GameFramework/Actor.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace RyRuntimeBenchmarks
+{
+
+// A named benchmark. Pass runs OpsPerPass operations.
+struct FBenchmark
+{
+    FString Name;
+    int32 OpsPerPass;
+    TFunction<void()> Pass;
+};
+
+struct FBenchmarkResult
+{
+    double NanosecondsPerOp = 0.0;
+    // Growth of the process's used physical memory over one pass. Coarse (allocators keep freed memory pooled), so it
+    // catches leaks and large retained buffers rather than every temporary allocation.
+    double MemoryGrowthKB = 0.0;
+};
+
+// Results written by passes so the optimizer can't throw the work away
+static volatile float GSink = 0.0f;
+
+// Input sizes. Batch paths are measured at a size typical of per-frame bulk work.
+static constexpr int32 NumElements = 4096;
+static constexpr int32 NumBits = 256 * 256;
+static constexpr int32 NumPolylinePoints = 1024;
+static const FIntVector NoiseGridSize(64, 64, 1);
+
+// Memory growth beyond the baseline that is reported, in KB
+static constexpr double MemoryGrowthToleranceKB = 64.0;
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+static FString GetBenchmarkDirectory()
+{
+    return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("RyRuntime"), TEXT("Benchmarks"));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * Baseline and result files are CSV lines of Name,NanosecondsPerOp,MemoryGrowthKB
+*/
+static TMap<FString, FBenchmarkResult> LoadResults(const FString& filePath)
+{
+    TMap<FString, FBenchmarkResult> results;
+    TArray<FString> lines;
+    if(!FFileHelper::LoadFileToStringArray(lines, *filePath))
+    {
+        return results;
+    }
+
+    for(const FString& line : lines)
+    {
+        TArray<FString> fields;
+        if(line.StartsWith(TEXT("#")) || line.ParseIntoArray(fields, TEXT(","), false) != 3)
+        {
+            continue;
+        }
+        FBenchmarkResult& result = results.Add(fields[0]);
+        result.NanosecondsPerOp = FCString::Atod(*fields[1]);
+        result.MemoryGrowthKB = FCString::Atod(*fields[2]);
+    }
+    return results;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+static bool SaveResults(const FString& filePath, const TArray<FBenchmark>& benchmarks, const TArray<FBenchmarkResult>& results)
+{
+    TArray<FString> lines;
+    lines.Add(TEXT("# Name,NanosecondsPerOp,MemoryGrowthKB"));
+    for(int32 index = 0; index < benchmarks.Num(); ++index)
+    {
+        lines.Add(FString::Printf(TEXT("%s,%.3f,%.1f"), *benchmarks[index].Name, results[index].NanosecondsPerOp, results[index].MemoryGrowthKB));
+    }
+    return FFileHelper::SaveStringArrayToFile(lines, *filePath);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * Run one warm up pass, one untimed pass measuring memory growth, then timed passes until minSeconds has passed (at least 3)
+*/
+static FBenchmarkResult RunBenchmark(const FBenchmark& benchmark, const double minSeconds)
+{
+    benchmark.Pass();
+
+    // The warm up pass has grown any pools and caches, so growth over this pass is memory the benchmark holds on to
+    const uint64 usedBefore = FPlatformMemory::GetStats().UsedPhysical;
+    benchmark.Pass();
+    const uint64 usedAfter = FPlatformMemory::GetStats().UsedPhysical;
+
+    int32 numPasses = 0;
+    const double startTime = FPlatformTime::Seconds();
+    double elapsed = 0.0;
+    do
+    {
+        benchmark.Pass();
+        ++numPasses;
+        elapsed = FPlatformTime::Seconds() - startTime;
+    }
+    while(elapsed < minSeconds || numPasses < 3);
+
+    const double numOps = static_cast<double>(numPasses) * benchmark.OpsPerPass;
+    FBenchmarkResult result;
+    result.NanosecondsPerOp = elapsed * 1.e9 / numOps;
+    result.MemoryGrowthKB = usedAfter > usedBefore ? static_cast<double>(usedAfter - usedBefore) / 1024.0 : 0.0;
+    return result;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * Inputs shared by the benchmarks. Built once per run so input generation isn't timed.
+*/
+struct FBenchmarkInputs
+{
+    TArray<float> Angles;
+    TArray<float> Targets;
+    TArray<float> Speeds;
+    TArray<float> Hyperbolic;
+    TArray<float> Output;
+    TArray<float> SecondOutput;
+    TArray<bool> BoolOutput;
+    TArray<FVector> Points;
+    TArray<FVector> VectorOutput;
+    TArray<FRotator> Rotators;
+    TArray<int32> IntKeys;
+    TArray<int32> SortedIndices;
+    TArray<FVector> Polyline;
+    TArray<FVector> PolylineOutput;
+    TArray<int32> KeptIndices;
+    TArray<float> NoiseOutput;
+    TArray<FTransform> TransformOutput;
+    FRySplineDistanceTable SplineTable;
+    TArray<float> SplineDistances;
+    TArray<FRyCatenaryCable> Cables;
+    FRyBitset BitsA;
+    FRyBitset BitsB;
+    TArray<int32> Indices;
+    TArray<FString> Words;
+    FString Sentence;
+    USceneComponent* Component = nullptr;
+    USplineComponent* Spline = nullptr;
+
+    FBenchmarkInputs()
+    {
+        FRandomStream randomStream(NumElements);
+        Angles.SetNumUninitialized(NumElements);
+        Targets.SetNumUninitialized(NumElements);
+        Speeds.SetNumUninitialized(NumElements);
+        Hyperbolic.SetNumUninitialized(NumElements);
+        Output.SetNumUninitialized(NumElements);
+        SecondOutput.SetNumUninitialized(NumElements);
+        BoolOutput.SetNumUninitialized(NumElements);
+        Points.SetNumUninitialized(NumElements);
+        VectorOutput.SetNumUninitialized(NumElements);
+        Rotators.SetNumUninitialized(NumElements);
+        IntKeys.SetNumUninitialized(NumElements);
+        for(int32 index = 0; index < NumElements; ++index)
+        {
+            Angles[index] = randomStream.FRandRange(-720.0f, 720.0f);
+            Targets[index] = randomStream.FRandRange(-720.0f, 720.0f);
+            Speeds[index] = randomStream.FRandRange(0.0f, 180.0f);
+            Hyperbolic[index] = randomStream.FRandRange(-5.0f, 5.0f);
+            Points[index] = randomStream.VRand() * randomStream.FRandRange(0.0f, 10000.0f);
+            Rotators[index] = FRotator(randomStream.FRandRange(-90.0f, 90.0f), randomStream.FRandRange(-180.0f, 180.0f), 0.0f);
+            IntKeys[index] = randomStream.RandRange(-1000000, 1000000);
+        }
+
+        // A noisy trace, like a recorded path, for simplification
+        Polyline.SetNumUninitialized(NumPolylinePoints);
+        for(int32 index = 0; index < NumPolylinePoints; ++index)
+        {
+            const float along = index * 10.0f;
+            Polyline[index] = FVector(along, FMath::Sin(along * 0.01f) * 500.0f + randomStream.FRandRange(-5.0f, 5.0f), 0.0f);
+        }
+
+        Cables.SetNum(64);
+        for(FRyCatenaryCable& cable : Cables)
+        {
+            cable.Start = randomStream.VRand() * 1000.0f;
+            cable.End = cable.Start + randomStream.VRand() * 1000.0f;
+            cable.Length = FVector::Dist(cable.Start, cable.End) * randomStream.FRandRange(1.0f, 2.0f);
+        }
+
+        BitsA.Init(NumBits, false);
+        BitsB.Init(NumBits, false);
+        for(int32 bitIndex = 0; bitIndex < NumBits; ++bitIndex)
+        {
+            BitsA.SetBit(bitIndex, randomStream.FRand() < 0.5f);
+            BitsB.SetBit(bitIndex, randomStream.FRand() < 0.1f);
+        }
+
+        for(int32 index = 0; index < 32; ++index)
+        {
+            Words.Add(FString::Printf(TEXT("word%d "), index));
+        }
+        Sentence = TEXT("the quick brown fox jumps over the lazy dog while the benchmark keeps running");
+
+        // Target for the property setting benchmark, kept alive for the run by the root set
+        Component = NewObject<USceneComponent>(GetTransientPackage());
+        Component->AddToRoot();
+
+        // Spline for the distance table benchmarks, a gentle S curve about 10000 units long
+        Spline = NewObject<USplineComponent>(GetTransientPackage());
+        Spline->AddToRoot();
+        Spline->ClearSplinePoints(false);
+        for(int32 pointIndex = 0; pointIndex < 8; ++pointIndex)
+        {
+            Spline->AddSplinePoint(FVector(pointIndex * 1250.0f, (pointIndex & 1) ? 400.0f : -400.0f, 0.0f), ESplineCoordinateSpace::Local, false);
+        }
+        Spline->UpdateSpline();
+        URyRuntimeComponentHelpers::UpdateSplineDistanceTable(Spline, SplineTable);
+        SplineDistances.SetNumUninitialized(NumElements);
+        for(int32 index = 0; index < NumElements; ++index)
+        {
+            SplineDistances[index] = randomStream.FRandRange(0.0f, SplineTable.GetLength());
+        }
+    }
+
+    ~FBenchmarkInputs()
+    {
+        Spline->RemoveFromRoot();
+        Component->RemoveFromRoot();
+    }
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * Every benchmark, in report order. Scalar helpers are timed over NumElements inputs per pass so call overhead
+ * dominates less, batch helpers over one NumElements sized call per pass.
+ * Latent and loading helpers (LoadAssetPriority, LoadPackagePriority) are asynchronous and not covered here.
+*/
+static void BuildBenchmarks(FBenchmarkInputs& in, TArray<FBenchmark>& benchmarks)
+{
+    typedef URyRuntimeMathHelpers FMathHelpers;
+    const int32 n = NumElements;
+
+    auto add = [&benchmarks](const TCHAR* name, const int32 opsPerPass, TFunction<void()> pass)
+    {
+        benchmarks.Add({name, opsPerPass, MoveTemp(pass)});
+    };
+
+    // Math, scalar
+    add(TEXT("Math.ShortestRotationPath"), n, [&in, n]() { for(int32 i = 0; i < n; ++i) { in.Output[i] = FMathHelpers::ShortestRotationPath(in.Angles[i], in.Targets[i]); } });
+    add(TEXT("Math.RotationsEqual"), n, [&in, n]() { for(int32 i = 0; i < n; ++i) { in.BoolOutput[i] = FMathHelpers::RotationsEqual(in.Angles[i], in.Targets[i]); } });
+    add(TEXT("Math.RotationInterpolate"), n, [&in, n]() { for(int32 i = 0; i < n; ++i) { FMathHelpers::RotationInterpolate(in.Angles[i], in.Targets[i], 1.0f / 60.0f, in.Speeds[i], in.Output[i], in.BoolOutput[i]); } });
+    add(TEXT("Math.ConvertUnit"), n, [&in, n]() { for(int32 i = 0; i < n; ++i) { in.Output[i] = FMathHelpers::ConvertUnit(in.Speeds[i], ERyUnit::Celsius, ERyUnit::Farenheit); } });
+    add(TEXT("Math.ConvertUnitWithPlan"), n, [&in, n]()
+    {
+        const FRyUnitConversionPlan plan = FMathHelpers::MakeUnitConversionPlan(ERyUnit::Celsius, ERyUnit::Farenheit);
+        for(int32 i = 0; i < n; ++i) { in.Output[i] = FMathHelpers::ConvertUnitWithPlan(in.Speeds[i], plan); }
+    });
+    add(TEXT("Math.SinH"), n, [&in, n]() { for(int32 i = 0; i < n; ++i) { in.Output[i] = FMathHelpers::SinH(in.Hyperbolic[i]); } });
+    add(TEXT("Math.FastSinH"), n, [&in, n]() { for(int32 i = 0; i < n; ++i) { in.Output[i] = FMathHelpers::FastSinH(in.Hyperbolic[i]); } });
+    add(TEXT("Math.CosH"), n, [&in, n]() { for(int32 i = 0; i < n; ++i) { in.Output[i] = FMathHelpers::CosH(in.Hyperbolic[i]); } });
+    add(TEXT("Math.FastCosH"), n, [&in, n]() { for(int32 i = 0; i < n; ++i) { in.Output[i] = FMathHelpers::FastCosH(in.Hyperbolic[i]); } });
+    add(TEXT("Math.FastSinCos"), n, [&in, n]() { for(int32 i = 0; i < n; ++i) { FMathHelpers::FastSinCos(in.Angles[i], in.Output[i], in.SecondOutput[i]); } });
+    add(TEXT("Math.FastAtan2"), n, [&in, n]() { for(int32 i = 0; i < n; ++i) { in.Output[i] = FMathHelpers::FastAtan2(in.Angles[i], in.Targets[i]); } });
+    add(TEXT("Math.CalculateCatenary"), n, [&in, n]() { for(int32 i = 0; i < n; ++i) { in.Output[i] = FMathHelpers::CalculateCatenary(in.Hyperbolic[i], 3.0f); } });
+    add(TEXT("Math.FastCalculateCatenary"), n, [&in, n]() { for(int32 i = 0; i < n; ++i) { in.Output[i] = FMathHelpers::FastCalculateCatenary(in.Hyperbolic[i], 3.0f); } });
+    add(TEXT("Math.SolveCatenaryScalingFactor"), n, [&in, n]() { for(int32 i = 0; i < n; ++i) { in.Output[i] = FMathHelpers::SolveCatenaryScalingFactor(100.0f, in.Hyperbolic[i], 200.0f + in.Speeds[i]); } });
+    add(TEXT("Math.Dot_VectorVector2D"), n, [&in, n]() { for(int32 i = 0; i < n; ++i) { in.Output[i] = FMathHelpers::Dot_VectorVector2D(in.Points[i], in.Points[0]); } });
+    add(TEXT("Math.EqualEqual_VectorVector2D"), n, [&in, n]() { for(int32 i = 0; i < n; ++i) { in.BoolOutput[i] = FMathHelpers::EqualEqual_VectorVector2D(in.Points[i], in.Points[0]); } });
+    add(TEXT("Math.GetForwardVector2D"), n, [&in, n]() { for(int32 i = 0; i < n; ++i) { in.VectorOutput[i] = FMathHelpers::GetForwardVector2D(in.Rotators[i]); } });
+    add(TEXT("Math.GetRightVector2D"), n, [&in, n]() { for(int32 i = 0; i < n; ++i) { in.VectorOutput[i] = FMathHelpers::GetRightVector2D(in.Rotators[i]); } });
+    add(TEXT("Math.ShiftLeft_Int64"), n, [&in, n]() { for(int32 i = 0; i < n; ++i) { in.Output[i] = static_cast<float>(FMathHelpers::ShiftLeft_Int64(i, i & 31)); } });
+    add(TEXT("Math.And_ByteByte"), n, [&in, n]() { for(int32 i = 0; i < n; ++i) { in.Output[i] = FMathHelpers::And_ByteByte(static_cast<uint8>(i), 0x5A); } });
+
+    // Math, batch
+    add(TEXT("Math.ShortestRotationPathArray"), n, [&in]() { FMathHelpers::ShortestRotationPathArray(in.Angles, in.Targets, in.Output); });
+    add(TEXT("Math.RotationInterpolateArray"), n, [&in]() { FMathHelpers::RotationInterpolateArray(in.Angles, in.Targets, 1.0f / 60.0f, in.Speeds, in.Output, in.BoolOutput); });
+    add(TEXT("Math.ConvertUnitArray"), n, [&in]() { FMathHelpers::ConvertUnitArray(in.Speeds, FMathHelpers::MakeUnitConversionPlan(ERyUnit::Celsius, ERyUnit::Farenheit), in.Output); });
+    add(TEXT("Math.Dot_VectorArray2D"), n, [&in]() { FMathHelpers::Dot_VectorArray2D(in.Points, in.Points[0], in.Output); });
+    add(TEXT("Math.DistanceSquared_VectorArray2D"), n, [&in]() { FMathHelpers::DistanceSquared_VectorArray2D(in.Points, in.Points[0], in.Output); });
+    add(TEXT("Math.FindNearestPoint2D"), n, [&in]() { float distanceSquared; GSink = static_cast<float>(FMathHelpers::FindNearestPoint2D(in.Points, in.Points[0], distanceSquared)); });
+    add(TEXT("Math.GetForwardVectors2D"), n, [&in]() { FMathHelpers::GetForwardVectors2D(in.Rotators, in.VectorOutput); });
+    add(TEXT("Math.FastSinHArray"), n, [&in]() { FMathHelpers::FastSinHArray(in.Hyperbolic, in.Output); });
+    add(TEXT("Math.FastCosHArray"), n, [&in]() { FMathHelpers::FastCosHArray(in.Hyperbolic, in.Output); });
+    add(TEXT("Math.FastSinCosArray"), n, [&in]() { FMathHelpers::FastSinCosArray(in.Angles, in.Output, in.SecondOutput); });
+    add(TEXT("Math.FastAtan2Array"), n, [&in]() { FMathHelpers::FastAtan2Array(in.Angles, in.Targets, in.Output); });
+    add(TEXT("Math.FastCalculateCatenaryArray"), n, [&in]() { FMathHelpers::FastCalculateCatenaryArray(in.Hyperbolic, 3.0f, in.Output); });
+    add(TEXT("Math.SumFloatArray"), n, [&in]() { GSink = FMathHelpers::SumFloatArray(in.Hyperbolic); });
+    add(TEXT("Math.MinFloatArray"), n, [&in]() { int32 minIndex; GSink = FMathHelpers::MinFloatArray(in.Hyperbolic, minIndex); });
+    add(TEXT("Math.VarianceFloatArray"), n, [&in]() { float mean; GSink = FMathHelpers::VarianceFloatArray(in.Hyperbolic, mean); });
+    add(TEXT("Math.LerpFloatArrayInline"), n, [&in]() { FMathHelpers::LerpFloatArrayInline(in.Output, in.Targets, 0.25f); });
+    add(TEXT("Math.NormalizeFloatArrayInline"), n, [&in]() { FMathHelpers::NormalizeFloatArrayInline(in.Output); });
+    add(TEXT("Math.SortIndicesByFloatKeys"), n, [&in]() { FMathHelpers::SortIndicesByFloatKeys(in.Angles, in.SortedIndices); });
+    add(TEXT("Math.SortIndicesByIntKeys"), n, [&in]() { FMathHelpers::SortIndicesByIntKeys(in.IntKeys, in.SortedIndices); });
+    add(TEXT("Math.TopKIndicesByFloatKeys"), n, [&in]() { FMathHelpers::TopKIndicesByFloatKeys(in.Angles, 16, in.SortedIndices); });
+    add(TEXT("Math.TopKIndicesByIntKeys"), n, [&in]() { FMathHelpers::TopKIndicesByIntKeys(in.IntKeys, 16, in.SortedIndices, true); });
+    add(TEXT("Math.SampleNoise.Simplex"), n, [&in, n]() { for(int32 i = 0; i < n; ++i) { in.Output[i] = FMathHelpers::SampleNoise(ERyNoiseType::Simplex, in.Points[i] * 0.01f, 0, 2); } });
+    add(TEXT("Math.FillNoiseGrid.Value"), NoiseGridSize.X * NoiseGridSize.Y, [&in]()
+    {
+        FMathHelpers::FillNoiseGrid(ERyNoiseType::Value, NoiseGridSize, FVector::ZeroVector, FVector(0.05f), in.NoiseOutput, 0, 2, false);
+    });
+    add(TEXT("Math.FillNoiseGrid.Perlin"), NoiseGridSize.X * NoiseGridSize.Y, [&in]()
+    {
+        FMathHelpers::FillNoiseGrid(ERyNoiseType::Perlin, NoiseGridSize, FVector::ZeroVector, FVector(0.05f), in.NoiseOutput, 0, 2, false);
+    });
+    add(TEXT("Math.FillNoiseGrid.Simplex"), NoiseGridSize.X * NoiseGridSize.Y, [&in]()
+    {
+        FMathHelpers::FillNoiseGrid(ERyNoiseType::Simplex, NoiseGridSize, FVector::ZeroVector, FVector(0.05f), in.NoiseOutput, 0, 2, false);
+    });
+    add(TEXT("Math.SolveCatenaryCables"), in.Cables.Num(), [&in]() { GSink = static_cast<float>(FMathHelpers::SolveCatenaryCables(in.Cables, true)); });
+
+    // Bitsets, ops are whole 256x256 bitsets
+    add(TEXT("Bitset.AndAssign"), 1, [&in]() { FRyBitset bits = in.BitsA; URyRuntimeBitsetHelpers::AndAssign_Bitset(bits, in.BitsB); GSink = static_cast<float>(bits.Words[0]); });
+    add(TEXT("Bitset.Not"), 1, [&in]() { GSink = static_cast<float>(URyRuntimeBitsetHelpers::Not_Bitset(in.BitsA).Words[0]); });
+    add(TEXT("Bitset.ShiftLeft"), 1, [&in]() { GSink = static_cast<float>(URyRuntimeBitsetHelpers::ShiftLeft_Bitset(in.BitsA, 257).Words[0]); });
+    add(TEXT("Bitset.CountSetBits"), 1, [&in]() { GSink = static_cast<float>(URyRuntimeBitsetHelpers::CountSetBits(in.BitsA)); });
+    add(TEXT("Bitset.FindFirstSetBit"), 1, [&in]() { GSink = static_cast<float>(URyRuntimeBitsetHelpers::FindFirstSetBit(in.BitsB, NumBits / 2)); });
+    add(TEXT("Bitset.GetSetBitIndices"), 1, [&in]() { URyRuntimeBitsetHelpers::GetSetBitIndices(in.BitsB, in.Indices); });
+
+    // Components, ops are input points or distances
+    add(TEXT("Component.SimplifyPolyline.DouglasPeucker"), NumPolylinePoints, [&in]()
+    {
+        URyRuntimeComponentHelpers::SimplifyPolyline(in.Polyline, ERyPolylineSimplification::DouglasPeucker, 20.0f, 0, in.PolylineOutput, in.KeptIndices);
+    });
+    add(TEXT("Component.SimplifyPolyline.Visvalingam"), NumPolylinePoints, [&in]()
+    {
+        URyRuntimeComponentHelpers::SimplifyPolyline(in.Polyline, ERyPolylineSimplification::Visvalingam, 2000.0f, 0, in.PolylineOutput, in.KeptIndices);
+    });
+    add(TEXT("Component.SampleSplineDistanceTable"), n, [&in, n]()
+    {
+        FVector location, tangent;
+        FRotator rotation;
+        for(int32 i = 0; i < n; ++i) { URyRuntimeComponentHelpers::SampleSplineDistanceTable(in.SplineTable, in.SplineDistances[i], ESplineCoordinateSpace::World, location, rotation, tangent); }
+        GSink = location.X;
+    });
+    add(TEXT("Component.SampleSplineDistanceTableBatch"), n, [&in]()
+    {
+        URyRuntimeComponentHelpers::SampleSplineDistanceTableBatch(in.SplineTable, in.SplineDistances, ESplineCoordinateSpace::World, in.TransformOutput);
+    });
+    add(TEXT("Component.UpdateSplineDistanceTable.Unchanged"), 1, [&in]() { GSink = URyRuntimeComponentHelpers::UpdateSplineDistanceTable(in.Spline, in.SplineTable); });
+
+    // Strings
+    add(TEXT("String.IsNone"), n, [n]() { for(int32 i = 0; i < n; ++i) { GSink = URyRuntimeStringHelpers::IsNone(NAME_Actor); } });
+    add(TEXT("String.IsEmpty"), n, [&in, n]() { for(int32 i = 0; i < n; ++i) { GSink = URyRuntimeStringHelpers::IsEmpty(in.Sentence); } });
+    add(TEXT("String.SetChar"), n, [&in, n]()
+    {
+        FString sentence = in.Sentence;
+        const FString charIn(TEXT("x"));
+        for(int32 i = 0; i < n; ++i) { URyRuntimeStringHelpers::SetChar(sentence, i % sentence.Len(), charIn); }
+    });
+    add(TEXT("String.CharToBytes"), n, [&in, n]()
+    {
+        uint8 byte1, byte2;
+        for(int32 i = 0; i < n; ++i) { URyRuntimeStringHelpers::CharToBytes(in.Sentence, i % in.Sentence.Len(), byte1, byte2); }
+        GSink = byte1;
+    });
+    add(TEXT("String.FillString"), 1, []() { FString filled; URyRuntimeStringHelpers::FillString(filled, 1024, TEXT("x")); GSink = filled.Len(); });
+    add(TEXT("String.AppendTo"), n, [&in, n]()
+    {
+        FString built;
+        for(int32 i = 0; i < n; ++i) { URyRuntimeStringHelpers::AppendTo(built, in.Words[i % in.Words.Num()]); }
+        GSink = built.Len();
+    });
+    add(TEXT("String.AppendStringsTo"), 1, [&in]() { FString built; URyRuntimeStringHelpers::AppendStringsTo(built, in.Words); GSink = built.Len(); });
+    add(TEXT("String.ToTitleString"), 1, [&in]() { GSink = URyRuntimeStringHelpers::ToTitleString(in.Sentence).Len(); });
+
+    // Objects
+    add(TEXT("Object.GetParentClass"), n, [n]() { for(int32 i = 0; i < n; ++i) { GSink = URyRuntimeObjectHelpers::GetParentClass(AActor::StaticClass()) != nullptr; } });
+    add(TEXT("Object.GetClassHierarchy"), 1, []() { TArray<UClass*> hierarchy; URyRuntimeObjectHelpers::GetClassHierarchy(USceneComponent::StaticClass(), hierarchy); GSink = hierarchy.Num(); });
+    add(TEXT("Object.GetClassDefaultObject"), n, [n]() { for(int32 i = 0; i < n; ++i) { GSink = URyRuntimeObjectHelpers::GetClassDefaultObject(AActor::StaticClass()) != nullptr; } });
+    add(TEXT("Object.GetPackageOfObject"), n, [&in, n]() { for(int32 i = 0; i < n; ++i) { GSink = URyRuntimeObjectHelpers::GetPackageOfObject(in.Component) != nullptr; } });
+    add(TEXT("Object.IsLiveSoftObjectReference"), n, [&in, n]()
+    {
+        const TSoftObjectPtr<UObject> softObject(in.Component);
+        for(int32 i = 0; i < n; ++i) { GSink = URyRuntimeObjectHelpers::IsLiveSoftObjectReference(softObject); }
+    });
+    add(TEXT("Object.FindOrLoadPackage"), 1, []() { GSink = URyRuntimeObjectHelpers::FindOrLoadPackage(TEXT("/Script/RyRuntime")) != nullptr; });
+    add(TEXT("Object.LoadObject"), 1, []() { GSink = URyRuntimeObjectHelpers::LoadObject(TEXT("/Script/Engine.Actor")) != nullptr; });
+    add(TEXT("Object.LoadObjectFromPackage"), 1, []()
+    {
+        GSink = URyRuntimeObjectHelpers::LoadObjectFromPackage(URyRuntimeObjectHelpers::FindOrLoadPackage(TEXT("/Script/Engine")), TEXT("Actor")) != nullptr;
+    });
+    add(TEXT("Object.GetObjectsInPackage"), 1, []()
+    {
+        TArray<UObject*> objects;
+        URyRuntimeObjectHelpers::GetObjectsInPackage(URyRuntimeObjectHelpers::FindOrLoadPackage(TEXT("/Script/RyRuntime")), objects);
+        GSink = objects.Num();
+    });
+    add(TEXT("Object.SetObjectPropertyValue"), 1, [&in]() { GSink = URyRuntimeObjectHelpers::SetObjectPropertyValue(in.Component, TEXT("bHiddenInGame"), TEXT("true"), false); });
+}
+
+} // namespace RyRuntimeBenchmarks
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRyRuntimeBenchmarksTest, "Ry.Benchmarks",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * Runs every benchmark, logs the table and fails on time regressions against the baseline.
+ * With no baseline yet, or with -RyBenchmarkSaveBaseline, the results become the baseline.
+*/
+bool FRyRuntimeBenchmarksTest::RunTest(const FString& Parameters)
+{
+    using namespace RyRuntimeBenchmarks;
+
+    FString filter;
+    float minMilliseconds = 100.0f;
+    float tolerance = 0.15f;
+    FParse::Value(FCommandLine::Get(), TEXT("RyBenchmarkFilter="), filter);
+    FParse::Value(FCommandLine::Get(), TEXT("RyBenchmarkMinMs="), minMilliseconds);
+    FParse::Value(FCommandLine::Get(), TEXT("RyBenchmarkTolerance="), tolerance);
+
+    FBenchmarkInputs inputs;
+    TArray<FBenchmark> benchmarks;
+    BuildBenchmarks(inputs, benchmarks);
+    if(!filter.IsEmpty())
+    {
+        benchmarks.RemoveAll([&filter](const FBenchmark& benchmark) { return !benchmark.Name.Contains(filter); });
+    }
+
+    const FString baselinePath = FPaths::Combine(GetBenchmarkDirectory(), TEXT("Baseline.csv"));
+    const TMap<FString, FBenchmarkResult> baseline = LoadResults(baselinePath);
+    // A partial (filtered) run never replaces the baseline on its own
+    const bool saveBaseline = FParse::Param(FCommandLine::Get(), TEXT("RyBenchmarkSaveBaseline")) || (baseline.Num() == 0 && filter.IsEmpty());
+
+    UE_LOG(LogRyRuntime, Display, TEXT("Ry.Benchmarks: %d benchmarks, %.0fms each, regression tolerance %.0f%%"), benchmarks.Num(), minMilliseconds, tolerance * 100.0f);
+    UE_LOG(LogRyRuntime, Display, TEXT("%-48s %12s %10s %12s %8s"), TEXT("Benchmark"), TEXT("ns/op"), TEXT("mem KB"), TEXT("base ns/op"), TEXT("delta"));
+
+    int32 numRegressions = 0;
+    TArray<FBenchmarkResult> results;
+    for(const FBenchmark& benchmark : benchmarks)
+    {
+        const FBenchmarkResult& result = results.Add_GetRef(RunBenchmark(benchmark, minMilliseconds / 1000.0));
+
+        const FBenchmarkResult* baseResult = baseline.Find(benchmark.Name);
+        if(!baseResult)
+        {
+            UE_LOG(LogRyRuntime, Display, TEXT("%-48s %12.2f %10.1f %12s %8s"), *benchmark.Name, result.NanosecondsPerOp, result.MemoryGrowthKB, TEXT("-"), TEXT("-"));
+            continue;
+        }
+
+        // Time is allowed to wobble within tolerance
+        const double delta = baseResult->NanosecondsPerOp > 0.0 ? result.NanosecondsPerOp / baseResult->NanosecondsPerOp - 1.0 : 0.0;
+        UE_LOG(LogRyRuntime, Display, TEXT("%-48s %12.2f %10.1f %12.2f %+7.1f%%"), *benchmark.Name, result.NanosecondsPerOp,
+               result.MemoryGrowthKB, baseResult->NanosecondsPerOp, delta * 100.0);
+        if(delta > tolerance)
+        {
+            ++numRegressions;
+            AddError(FString::Printf(TEXT("%s: %.2f ns/op is %.1f%% slower than the baseline %.2f ns/op"), *benchmark.Name,
+                                     result.NanosecondsPerOp, delta * 100.0, baseResult->NanosecondsPerOp));
+        }
+
+        // Physical memory use is too noisy to fail on, but growth over a pass the baseline didn't have is worth a look
+        if(result.MemoryGrowthKB > baseResult->MemoryGrowthKB + MemoryGrowthToleranceKB)
+        {
+            AddWarning(FString::Printf(TEXT("%s: Memory grew %.1fKB over one pass, baseline %.1fKB"), *benchmark.Name,
+                                       result.MemoryGrowthKB, baseResult->MemoryGrowthKB));
+        }
+    }
+
+    const FString latestPath = FPaths::Combine(GetBenchmarkDirectory(), TEXT("Latest.csv"));
+    SaveResults(latestPath, benchmarks, results);
+    if(saveBaseline)
+    {
+        SaveResults(baselinePath, benchmarks, results);
+        UE_LOG(LogRyRuntime, Display, TEXT("Ry.Benchmarks: Saved baseline to %s"), *baselinePath);
+    }
+
+    UE_LOG(LogRyRuntime, Display, TEXT("Ry.Benchmarks: %d regressions against baseline. Results in %s"), numRegressions, *latestPath);
+    return numRegressions == 0;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
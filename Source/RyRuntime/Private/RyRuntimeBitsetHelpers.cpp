@@ -0,0 +1,387 @@
+// Copyright 2020-2021 Sheffer Online Services.
+// MIT License. See LICENSE for details.
+
+#include "RyRuntimeBitsetHelpers.h"
+#include "Math/VectorRegister.h"
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void FRyBitset::Init(const int32 numBits, const bool value)
+{
+    NumBits = FMath::Max(numBits, 0);
+    Words.Init(value ? ~uint64(0) : uint64(0), FMath::DivideAndRoundUp(NumBits, BitsPerWord));
+    ClearUnusedBits();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * Applies a binary word operation over the words of A and B, 2 words per SIMD register.
+ * Words of A past the end of B see a zero word from B.
+*/
+template<typename VectorOpType, typename ScalarOpType>
+static FORCEINLINE void BitsetBinaryOp(FRyBitset& A, const FRyBitset& B, VectorOpType vectorOp, ScalarOpType scalarOp)
+{
+    uint64* dst = A.Words.GetData();
+    const uint64* src = B.Words.GetData();
+    const int32 numShared = FMath::Min(A.NumWords(), B.NumWords());
+
+    int32 wordIndex = 0;
+    for(; wordIndex + 2 <= numShared; wordIndex += 2)
+    {
+        const VectorRegisterInt a = VectorIntLoad(dst + wordIndex);
+        const VectorRegisterInt b = VectorIntLoad(src + wordIndex);
+        VectorIntStore(vectorOp(a, b), dst + wordIndex);
+    }
+    for(; wordIndex < numShared; ++wordIndex)
+    {
+        dst[wordIndex] = scalarOp(dst[wordIndex], src[wordIndex]);
+    }
+    for(; wordIndex < A.NumWords(); ++wordIndex)
+    {
+        dst[wordIndex] = scalarOp(dst[wordIndex], uint64(0));
+    }
+    A.ClearUnusedBits();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+FRyBitset URyRuntimeBitsetHelpers::MakeBitset(const int32 numBits, const bool value)
+{
+    return FRyBitset(numBits, value);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+int32 URyRuntimeBitsetHelpers::GetNumBits(const FRyBitset& bitset)
+{
+    return bitset.NumBits;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+bool URyRuntimeBitsetHelpers::GetBit(const FRyBitset& bitset, const int32 bitIndex)
+{
+    return bitset.IsValidIndex(bitIndex) && bitset.GetBit(bitIndex);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeBitsetHelpers::SetBit(FRyBitset& bitset, const int32 bitIndex, const bool value)
+{
+    if(bitset.IsValidIndex(bitIndex))
+    {
+        bitset.SetBit(bitIndex, value);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeBitsetHelpers::SetBitRange(FRyBitset& bitset, const int32 startIndex, const int32 numBits, const bool value)
+{
+    const int32 firstBit = FMath::Max(startIndex, 0);
+    const int32 endBit = FMath::Min(startIndex + FMath::Max(numBits, 0), bitset.NumBits);
+    if(firstBit >= endBit)
+    {
+        return;
+    }
+
+    const int32 firstWord = firstBit / FRyBitset::BitsPerWord;
+    const int32 lastWord = (endBit - 1) / FRyBitset::BitsPerWord;
+    for(int32 wordIndex = firstWord; wordIndex <= lastWord; ++wordIndex)
+    {
+        uint64 mask = ~uint64(0);
+        if(wordIndex == firstWord)
+        {
+            mask &= ~uint64(0) << (firstBit % FRyBitset::BitsPerWord);
+        }
+        if(wordIndex == lastWord && (endBit % FRyBitset::BitsPerWord) != 0)
+        {
+            mask &= (uint64(1) << (endBit % FRyBitset::BitsPerWord)) - 1;
+        }
+
+        uint64& word = bitset.Words[wordIndex];
+        word = value ? (word | mask) : (word & ~mask);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeBitsetHelpers::SetAllBits(FRyBitset& bitset, const bool value)
+{
+    bitset.Init(bitset.NumBits, value);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+FRyBitset URyRuntimeBitsetHelpers::And_BitsetBitset(const FRyBitset& A, const FRyBitset& B)
+{
+    FRyBitset result = A;
+    AndAssign_Bitset(result, B);
+    return result;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+FRyBitset URyRuntimeBitsetHelpers::Or_BitsetBitset(const FRyBitset& A, const FRyBitset& B)
+{
+    FRyBitset result = A;
+    OrAssign_Bitset(result, B);
+    return result;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+FRyBitset URyRuntimeBitsetHelpers::Xor_BitsetBitset(const FRyBitset& A, const FRyBitset& B)
+{
+    FRyBitset result = A;
+    XorAssign_Bitset(result, B);
+    return result;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+FRyBitset URyRuntimeBitsetHelpers::Not_Bitset(const FRyBitset& A)
+{
+    FRyBitset result = A;
+    NotAssign_Bitset(result);
+    return result;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeBitsetHelpers::AndAssign_Bitset(FRyBitset& A, const FRyBitset& B)
+{
+    BitsetBinaryOp(A, B,
+        [](const VectorRegisterInt& a, const VectorRegisterInt& b) { return VectorIntAnd(a, b); },
+        [](const uint64 a, const uint64 b) { return a & b; });
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeBitsetHelpers::OrAssign_Bitset(FRyBitset& A, const FRyBitset& B)
+{
+    BitsetBinaryOp(A, B,
+        [](const VectorRegisterInt& a, const VectorRegisterInt& b) { return VectorIntOr(a, b); },
+        [](const uint64 a, const uint64 b) { return a | b; });
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeBitsetHelpers::XorAssign_Bitset(FRyBitset& A, const FRyBitset& B)
+{
+    BitsetBinaryOp(A, B,
+        [](const VectorRegisterInt& a, const VectorRegisterInt& b) { return VectorIntXor(a, b); },
+        [](const uint64 a, const uint64 b) { return a ^ b; });
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeBitsetHelpers::AndNotAssign_Bitset(FRyBitset& A, const FRyBitset& B)
+{
+    BitsetBinaryOp(A, B,
+        [](const VectorRegisterInt& a, const VectorRegisterInt& b) { return VectorIntAndNot(b, a); },
+        [](const uint64 a, const uint64 b) { return a & ~b; });
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeBitsetHelpers::NotAssign_Bitset(FRyBitset& A)
+{
+    uint64* words = A.Words.GetData();
+    const int32 numWords = A.NumWords();
+
+    int32 wordIndex = 0;
+    for(; wordIndex + 2 <= numWords; wordIndex += 2)
+    {
+        VectorIntStore(VectorIntNot(VectorIntLoad(words + wordIndex)), words + wordIndex);
+    }
+    for(; wordIndex < numWords; ++wordIndex)
+    {
+        words[wordIndex] = ~words[wordIndex];
+    }
+    A.ClearUnusedBits();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+FRyBitset URyRuntimeBitsetHelpers::ShiftLeft_Bitset(const FRyBitset& A, const int32 shift)
+{
+    if(shift < 0)
+    {
+        return ShiftRight_Bitset(A, -shift);
+    }
+
+    FRyBitset result(A.NumBits, false);
+    const int32 numWords = A.NumWords();
+    const int32 wordShift = shift / FRyBitset::BitsPerWord;
+    const int32 bitShift = shift % FRyBitset::BitsPerWord;
+    for(int32 wordIndex = wordShift; wordIndex < numWords; ++wordIndex)
+    {
+        const int32 srcIndex = wordIndex - wordShift;
+        uint64 word = A.Words[srcIndex] << bitShift;
+        if(bitShift != 0 && srcIndex > 0)
+        {
+            word |= A.Words[srcIndex - 1] >> (FRyBitset::BitsPerWord - bitShift);
+        }
+        result.Words[wordIndex] = word;
+    }
+    result.ClearUnusedBits();
+    return result;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+FRyBitset URyRuntimeBitsetHelpers::ShiftRight_Bitset(const FRyBitset& A, const int32 shift)
+{
+    if(shift < 0)
+    {
+        return ShiftLeft_Bitset(A, -shift);
+    }
+
+    FRyBitset result(A.NumBits, false);
+    const int32 numWords = A.NumWords();
+    const int32 wordShift = shift / FRyBitset::BitsPerWord;
+    const int32 bitShift = shift % FRyBitset::BitsPerWord;
+    for(int32 wordIndex = 0; wordIndex + wordShift < numWords; ++wordIndex)
+    {
+        const int32 srcIndex = wordIndex + wordShift;
+        uint64 word = A.Words[srcIndex] >> bitShift;
+        if(bitShift != 0 && srcIndex + 1 < numWords)
+        {
+            word |= A.Words[srcIndex + 1] << (FRyBitset::BitsPerWord - bitShift);
+        }
+        result.Words[wordIndex] = word;
+    }
+    return result;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+bool URyRuntimeBitsetHelpers::EqualEqual_BitsetBitset(const FRyBitset& A, const FRyBitset& B)
+{
+    return A.NumBits == B.NumBits && FMemory::Memcmp(A.Words.GetData(), B.Words.GetData(), A.Words.Num() * sizeof(uint64)) == 0;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+int32 URyRuntimeBitsetHelpers::CountSetBits(const FRyBitset& bitset)
+{
+    int32 count = 0;
+    for(const uint64 word : bitset.Words)
+    {
+        count += static_cast<int32>(FPlatformMath::CountBits(word));
+    }
+    return count;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+bool URyRuntimeBitsetHelpers::AnyBitSet(const FRyBitset& bitset)
+{
+    const uint64* words = bitset.Words.GetData();
+    const int32 numWords = bitset.NumWords();
+
+    // OR everything together and test once
+    VectorRegisterInt accumulated = GlobalVectorConstants::IntZero;
+    int32 wordIndex = 0;
+    for(; wordIndex + 2 <= numWords; wordIndex += 2)
+    {
+        accumulated = VectorIntOr(accumulated, VectorIntLoad(words + wordIndex));
+    }
+
+    uint64 tail[2];
+    VectorIntStore(accumulated, tail);
+    uint64 any = tail[0] | tail[1];
+    for(; wordIndex < numWords; ++wordIndex)
+    {
+        any |= words[wordIndex];
+    }
+    return any != 0;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+int32 URyRuntimeBitsetHelpers::FindFirstSetBit(const FRyBitset& bitset, const int32 startIndex)
+{
+    const int32 firstBit = FMath::Max(startIndex, 0);
+    if(firstBit >= bitset.NumBits)
+    {
+        return INDEX_NONE;
+    }
+
+    int32 wordIndex = firstBit / FRyBitset::BitsPerWord;
+    uint64 word = bitset.Words[wordIndex] & (~uint64(0) << (firstBit % FRyBitset::BitsPerWord));
+    while(word == 0)
+    {
+        if(++wordIndex >= bitset.NumWords())
+        {
+            return INDEX_NONE;
+        }
+        word = bitset.Words[wordIndex];
+    }
+
+    // Unused bits are always zero so this can't be past the end
+    return wordIndex * FRyBitset::BitsPerWord + static_cast<int32>(FPlatformMath::CountTrailingZeros64(word));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+int32 URyRuntimeBitsetHelpers::FindFirstUnsetBit(const FRyBitset& bitset, const int32 startIndex)
+{
+    const int32 firstBit = FMath::Max(startIndex, 0);
+    if(firstBit >= bitset.NumBits)
+    {
+        return INDEX_NONE;
+    }
+
+    int32 wordIndex = firstBit / FRyBitset::BitsPerWord;
+    uint64 word = ~bitset.Words[wordIndex] & (~uint64(0) << (firstBit % FRyBitset::BitsPerWord));
+    while(word == 0)
+    {
+        if(++wordIndex >= bitset.NumWords())
+        {
+            return INDEX_NONE;
+        }
+        word = ~bitset.Words[wordIndex];
+    }
+
+    // The inverted unused bits read as unset, so range check the answer
+    const int32 bitIndex = wordIndex * FRyBitset::BitsPerWord + static_cast<int32>(FPlatformMath::CountTrailingZeros64(word));
+    return bitIndex < bitset.NumBits ? bitIndex : INDEX_NONE;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeBitsetHelpers::GetSetBitIndices(const FRyBitset& bitset, TArray<int32>& indicesOut, const int32 startIndex, const int32 numBits)
+{
+    indicesOut.Reset();
+    const int32 endIndex = numBits < 0 ? bitset.NumBits : startIndex + numBits;
+    bitset.ForEachSetBit(startIndex, endIndex, [&indicesOut](const int32 bitIndex)
+    {
+        indicesOut.Add(bitIndex);
+    });
+}
@@ -3,6 +3,11 @@
 
 #include "RyRuntimeComponentHelpers.h"
 #include "RyRuntimeModule.h"
+#include "Algo/BinarySearch.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "GameFramework/Actor.h"
+#include "Materials/MaterialInterface.h"
 
 //---------------------------------------------------------------------------------------------------------------------
 /**
@@ -89,13 +94,624 @@ void URyRuntimeComponentHelpers::DistributePointsToSpline(USplineComponent* spli
 //---------------------------------------------------------------------------------------------------------------------
 /**
 */
-void URyRuntimeComponentHelpers::CopyCollisionProperties(UPrimitiveComponent* sourceMesh, UPrimitiveComponent* destMesh)
+void URyRuntimeComponentHelpers::SetSplinePointsBulk(USplineComponent* splineComponent,
+                                                     const TArray<FVector>& points,
+                                                     ESplineCoordinateSpace::Type coordinateSpace,
+                                                     const int32 numSplinePoints,
+                                                     const bool resampleByArcLength,
+                                                     bool updateSpline)
 {
-	if(!sourceMesh || !destMesh)
+	if(!splineComponent)
 	{
+		UE_LOG(LogRyRuntime, Warning, TEXT("SetSplinePointsBulk called with null splineComponent!"));
 		return;
 	}
 
+	if(points.Num() < 2)
+	{
+		UE_LOG(LogRyRuntime, Warning, TEXT("SetSplinePointsBulk called with not enough points... Requires (>=2)"));
+		return;
+	}
+
+	const int32 numOutPoints = numSplinePoints > 0 ? FMath::Max(numSplinePoints, 2) : points.Num();
+	TArray<FVector> splinePoints;
+	if(resampleByArcLength)
+	{
+		// Even when the count is unchanged, so unevenly sampled input comes out evenly spaced
+		ResamplePolylineByArcLength(points, numOutPoints, splinePoints);
+	}
+	else if(numOutPoints == points.Num())
+	{
+		splinePoints = points;
+	}
+	else
+	{
+		// Evenly by input index
+		splinePoints.SetNumUninitialized(numOutPoints);
+		const float indexStep = static_cast<float>(points.Num() - 1) / (numOutPoints - 1);
+		for(int32 pointIndex = 0; pointIndex < numOutPoints; ++pointIndex)
+		{
+			const float pointFrac = pointIndex * indexStep;
+			const int32 lowIndex = FMath::Min(FMath::FloorToInt(pointFrac), points.Num() - 2);
+			splinePoints[pointIndex] = FMath::Lerp(points[lowIndex], points[lowIndex + 1], pointFrac - lowIndex);
+		}
+		splinePoints.Last() = points.Last();
+	}
+
+	if(coordinateSpace == ESplineCoordinateSpace::World)
+	{
+		const FTransform& componentTransform = splineComponent->GetComponentTransform();
+		for(FVector& splinePoint : splinePoints)
+		{
+			splinePoint = componentTransform.InverseTransformPosition(splinePoint);
+		}
+	}
+
+	// Write the curves directly, all three must stay the same length
+	FSplineCurves& splineCurves = splineComponent->SplineCurves;
+	TArray<FInterpCurvePoint<FVector>>& positions = splineCurves.Position.Points;
+	TArray<FInterpCurvePoint<FQuat>>& rotations = splineCurves.Rotation.Points;
+	TArray<FInterpCurvePoint<FVector>>& scales = splineCurves.Scale.Points;
+
+	positions.SetNum(numOutPoints);
+	const int32 numOldRotations = rotations.Num();
+	rotations.SetNum(numOutPoints);
+	const int32 numOldScales = scales.Num();
+	scales.SetNum(numOutPoints);
+	for(int32 pointIndex = 0; pointIndex < numOutPoints; ++pointIndex)
+	{
+		const float inVal = static_cast<float>(pointIndex);
+		positions[pointIndex] = FInterpCurvePoint<FVector>(inVal, splinePoints[pointIndex], FVector::ZeroVector, FVector::ZeroVector, CIM_CurveAuto);
+		if(pointIndex < numOldRotations)
+		{
+			rotations[pointIndex].InVal = inVal;
+		}
+		else
+		{
+			rotations[pointIndex] = FInterpCurvePoint<FQuat>(inVal, FQuat::Identity, FQuat::Identity, FQuat::Identity, CIM_CurveAuto);
+		}
+		if(pointIndex < numOldScales)
+		{
+			scales[pointIndex].InVal = inVal;
+		}
+		else
+		{
+			scales[pointIndex] = FInterpCurvePoint<FVector>(inVal, FVector::OneVector, FVector::ZeroVector, FVector::ZeroVector, CIM_CurveAuto);
+		}
+	}
+
+	if(updateSpline)
+	{
+		splineComponent->UpdateSpline();
+	}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeComponentHelpers::ResamplePolylineByArcLength(const TArray<FVector>& points, const int32 numPoints, TArray<FVector>& pointsOut)
+{
+	pointsOut.Reset();
+	if(points.Num() < 2 || numPoints < 2)
+	{
+		pointsOut = points;
+		return;
+	}
+
+	// Cumulative distance to each input point
+	TArray<float> distances;
+	distances.SetNumUninitialized(points.Num());
+	distances[0] = 0.0f;
+	for(int32 pointIndex = 1; pointIndex < points.Num(); ++pointIndex)
+	{
+		distances[pointIndex] = distances[pointIndex - 1] + FVector::Dist(points[pointIndex - 1], points[pointIndex]);
+	}
+
+	const float totalDistance = distances.Last();
+	pointsOut.SetNumUninitialized(numPoints);
+	if(totalDistance <= SMALL_NUMBER)
+	{
+		for(FVector& point : pointsOut)
+		{
+			point = points[0];
+		}
+		return;
+	}
+
+	// Targets increase monotonically, so walk the segments once
+	const float step = totalDistance / (numPoints - 1);
+	int32 segmentIndex = 0;
+	for(int32 pointIndex = 0; pointIndex < numPoints - 1; ++pointIndex)
+	{
+		const float targetDistance = pointIndex * step;
+		while(segmentIndex < points.Num() - 2 && distances[segmentIndex + 1] < targetDistance)
+		{
+			++segmentIndex;
+		}
+
+		const float segmentLength = distances[segmentIndex + 1] - distances[segmentIndex];
+		const float alpha = segmentLength > SMALL_NUMBER ? FMath::Clamp((targetDistance - distances[segmentIndex]) / segmentLength, 0.0f, 1.0f) : 0.0f;
+		pointsOut[pointIndex] = FMath::Lerp(points[segmentIndex], points[segmentIndex + 1], alpha);
+	}
+	pointsOut.Last() = points.Last();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeComponentHelpers::DistributeSimplifiedPointsToSpline(USplineComponent* splineComponent,
+                                                                    const TArray<FVector>& points,
+                                                                    ESplineCoordinateSpace::Type coordinateSpace,
+                                                                    const ERyPolylineSimplification method,
+                                                                    const float tolerance,
+                                                                    const int32 maxPoints,
+                                                                    bool updateSpline)
+{
+	if(!splineComponent)
+	{
+		UE_LOG(LogRyRuntime, Warning, TEXT("DistributeSimplifiedPointsToSpline called with null splineComponent!"));
+		return;
+	}
+
+	if(points.Num() < 2)
+	{
+		UE_LOG(LogRyRuntime, Warning, TEXT("DistributeSimplifiedPointsToSpline called with not enough points... Requires (>=2)"));
+		return;
+	}
+
+	TArray<FVector> simplifiedPoints;
+	TArray<int32> keptIndices;
+	SimplifyPolyline(points, method, tolerance, maxPoints, simplifiedPoints, keptIndices);
+
+	SetSplinePointsBulk(splineComponent, simplifiedPoints, coordinateSpace, 0, false, updateSpline);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeComponentHelpers::SimplifyPolyline(const TArray<FVector>& points, const ERyPolylineSimplification method, const float tolerance,
+                                                  const int32 maxPoints, TArray<FVector>& pointsOut, TArray<int32>& keptIndicesOut)
+{
+	if(method == ERyPolylineSimplification::Visvalingam)
+	{
+		SimplifyPolylineVisvalingam(points, tolerance, maxPoints, keptIndicesOut);
+	}
+	else
+	{
+		SimplifyPolylineDouglasPeucker(points, tolerance, maxPoints, keptIndicesOut);
+	}
+
+	pointsOut.Reset(keptIndicesOut.Num());
+	for(const int32 keptIndex : keptIndicesOut)
+	{
+		pointsOut.Add(points[keptIndex]);
+	}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * Fill keptIndicesOut with the indices of points flagged in keep
+*/
+static void GatherKeptIndices(const TArray<bool>& keep, const int32 numKept, TArray<int32>& keptIndicesOut)
+{
+	keptIndicesOut.Reset(numKept);
+	for(int32 pointIndex = 0; pointIndex < keep.Num(); ++pointIndex)
+	{
+		if(keep[pointIndex])
+		{
+			keptIndicesOut.Add(pointIndex);
+		}
+	}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * Douglas-Peucker, refining the worst segment first rather than recursing depth first. This makes a point budget
+ * (maxPoints) keep the points which matter most, and it can't overflow the stack on long traces.
+*/
+void URyRuntimeComponentHelpers::SimplifyPolylineDouglasPeucker(const TArray<FVector>& points, const float tolerance, const int32 maxPoints,
+                                                                TArray<int32>& keptIndicesOut)
+{
+	const int32 numPoints = points.Num();
+	if(numPoints < 3)
+	{
+		keptIndicesOut.Reset(numPoints);
+		for(int32 pointIndex = 0; pointIndex < numPoints; ++pointIndex)
+		{
+			keptIndicesOut.Add(pointIndex);
+		}
+		return;
+	}
+
+	struct FSegment
+	{
+		int32 Start;
+		int32 End;
+		int32 Farthest;
+		float DistanceSquared;
+	};
+
+	auto makeSegment = [&points](const int32 start, const int32 end)
+	{
+		FSegment segment = {start, end, INDEX_NONE, -1.0f};
+		for(int32 pointIndex = start + 1; pointIndex < end; ++pointIndex)
+		{
+			const float distanceSquared = FMath::PointDistToSegmentSquared(points[pointIndex], points[start], points[end]);
+			if(distanceSquared > segment.DistanceSquared)
+			{
+				segment.Farthest = pointIndex;
+				segment.DistanceSquared = distanceSquared;
+			}
+		}
+		return segment;
+	};
+
+	// Worst segment at the top of the heap
+	auto worstFirst = [](const FSegment& A, const FSegment& B) { return A.DistanceSquared > B.DistanceSquared; };
+
+	const float toleranceSquared = FMath::Square(FMath::Max(tolerance, 0.0f));
+	const int32 maxKept = maxPoints > 0 ? FMath::Max(maxPoints, 2) : MAX_int32;
+
+	TArray<bool> keep;
+	keep.SetNumZeroed(numPoints);
+	keep[0] = true;
+	keep[numPoints - 1] = true;
+	int32 numKept = 2;
+
+	TArray<FSegment> segmentHeap;
+	segmentHeap.HeapPush(makeSegment(0, numPoints - 1), worstFirst);
+	while(segmentHeap.Num() > 0 && numKept < maxKept)
+	{
+		FSegment segment;
+		segmentHeap.HeapPop(segment, worstFirst, false);
+		if(segment.DistanceSquared <= toleranceSquared)
+		{
+			// Every remaining segment is within tolerance too
+			break;
+		}
+
+		keep[segment.Farthest] = true;
+		++numKept;
+		if(segment.Farthest - segment.Start > 1)
+		{
+			segmentHeap.HeapPush(makeSegment(segment.Start, segment.Farthest), worstFirst);
+		}
+		if(segment.End - segment.Farthest > 1)
+		{
+			segmentHeap.HeapPush(makeSegment(segment.Farthest, segment.End), worstFirst);
+		}
+	}
+
+	GatherKeptIndices(keep, numKept, keptIndicesOut);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * Visvalingam-Whyatt, repeatedly dropping the point whose triangle with its neighbours has the least area.
+ * Stale heap entries are skipped rather than removed, and a point's area never drops below that of a point removed
+ * before it, so removal order stays monotonic.
+*/
+void URyRuntimeComponentHelpers::SimplifyPolylineVisvalingam(const TArray<FVector>& points, const float minArea, const int32 maxPoints,
+                                                             TArray<int32>& keptIndicesOut)
+{
+	const int32 numPoints = points.Num();
+	if(numPoints < 3)
+	{
+		keptIndicesOut.Reset(numPoints);
+		for(int32 pointIndex = 0; pointIndex < numPoints; ++pointIndex)
+		{
+			keptIndicesOut.Add(pointIndex);
+		}
+		return;
+	}
+
+	struct FEntry
+	{
+		float Area;
+		int32 PointIndex;
+	};
+
+	auto triangleArea = [&points](const int32 a, const int32 b, const int32 c)
+	{
+		return 0.5f * ((points[b] - points[a]) ^ (points[c] - points[a])).Size();
+	};
+
+	// Smallest area at the top of the heap
+	auto smallestFirst = [](const FEntry& A, const FEntry& B) { return A.Area < B.Area; };
+
+	TArray<int32> previous, next;
+	TArray<float> areas;
+	TArray<FEntry> heap;
+	previous.SetNumUninitialized(numPoints);
+	next.SetNumUninitialized(numPoints);
+	areas.SetNumUninitialized(numPoints);
+	heap.Reserve(numPoints);
+	for(int32 pointIndex = 0; pointIndex < numPoints; ++pointIndex)
+	{
+		previous[pointIndex] = pointIndex - 1;
+		next[pointIndex] = pointIndex + 1;
+		areas[pointIndex] = MAX_flt;
+		if(pointIndex > 0 && pointIndex < numPoints - 1)
+		{
+			areas[pointIndex] = triangleArea(pointIndex - 1, pointIndex, pointIndex + 1);
+			heap.Add(FEntry{areas[pointIndex], pointIndex});
+		}
+	}
+	heap.Heapify(smallestFirst);
+
+	const int32 maxKept = maxPoints > 0 ? FMath::Max(maxPoints, 2) : MAX_int32;
+	TArray<bool> keep;
+	keep.Init(true, numPoints);
+	int32 numKept = numPoints;
+
+	while(heap.Num() > 0 && numKept > 2)
+	{
+		FEntry entry;
+		heap.HeapPop(entry, smallestFirst, false);
+		const int32 pointIndex = entry.PointIndex;
+		if(!keep[pointIndex] || entry.Area != areas[pointIndex])
+		{
+			continue;
+		}
+
+		// Points which add no area always go, otherwise stop once both limits are met
+		if(entry.Area > 0.0f && entry.Area >= minArea && numKept <= maxKept)
+		{
+			break;
+		}
+
+		keep[pointIndex] = false;
+		--numKept;
+		const int32 previousIndex = previous[pointIndex];
+		const int32 nextIndex = next[pointIndex];
+		next[previousIndex] = nextIndex;
+		previous[nextIndex] = previousIndex;
+
+		for(const int32 neighbourIndex : {previousIndex, nextIndex})
+		{
+			if(neighbourIndex > 0 && neighbourIndex < numPoints - 1)
+			{
+				areas[neighbourIndex] = FMath::Max(triangleArea(previous[neighbourIndex], neighbourIndex, next[neighbourIndex]), entry.Area);
+				heap.HeapPush(FEntry{areas[neighbourIndex], neighbourIndex}, smallestFirst);
+			}
+		}
+	}
+
+	GatherKeptIndices(keep, numKept, keptIndicesOut);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void FRySplineDistanceTable::Sample(float distance, FVector& locationOut, FQuat& rotationOut, FVector& tangentOut) const
+{
+	if(!IsBuilt())
+	{
+		locationOut = FVector::ZeroVector;
+		rotationOut = FQuat::Identity;
+		tangentOut = FVector::ZeroVector;
+		return;
+	}
+
+	const float length = GetLength();
+	if(ClosedLoop && length > 0.0f)
+	{
+		distance = FMath::Fmod(distance, length);
+		if(distance < 0.0f)
+		{
+			distance += length;
+		}
+	}
+	else
+	{
+		distance = FMath::Clamp(distance, 0.0f, length);
+	}
+
+	// First sample past distance, the sample before it starts the span
+	const int32 highIndex = FMath::Clamp(static_cast<int32>(Algo::UpperBound(Distances, distance)), 1, Distances.Num() - 1);
+	const int32 lowIndex = highIndex - 1;
+	const float spanLength = Distances[highIndex] - Distances[lowIndex];
+	const float alpha = spanLength > SMALL_NUMBER ? (distance - Distances[lowIndex]) / spanLength : 0.0f;
+
+	locationOut = FMath::Lerp(Locations[lowIndex], Locations[highIndex], alpha);
+	tangentOut = FMath::Lerp(Tangents[lowIndex], Tangents[highIndex], alpha);
+	rotationOut = FQuat::Slerp(Rotations[lowIndex], Rotations[highIndex], alpha);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+uint32 URyRuntimeComponentHelpers::HashSplineCurves(const USplineComponent* splineComponent)
+{
+	if(!splineComponent)
+	{
+		return 0;
+	}
+
+	// Hash the fields rather than the whole points, padding bytes aren't initialized
+	uint32 hash = 0;
+	auto hashCurve = [&hash](const auto& curve)
+	{
+		for(const auto& point : curve.Points)
+		{
+			const uint8 interpMode = point.InterpMode;
+			hash = FCrc::MemCrc32(&point.InVal, sizeof(point.InVal), hash);
+			hash = FCrc::MemCrc32(&point.OutVal, sizeof(point.OutVal), hash);
+			hash = FCrc::MemCrc32(&point.ArriveTangent, sizeof(point.ArriveTangent), hash);
+			hash = FCrc::MemCrc32(&point.LeaveTangent, sizeof(point.LeaveTangent), hash);
+			hash = FCrc::MemCrc32(&interpMode, sizeof(interpMode), hash);
+		}
+		const uint8 looped = curve.bIsLooped;
+		hash = FCrc::MemCrc32(&looped, sizeof(looped), hash);
+		hash = FCrc::MemCrc32(&curve.LoopKeyOffset, sizeof(curve.LoopKeyOffset), hash);
+	};
+
+	const FSplineCurves& splineCurves = splineComponent->SplineCurves;
+	hashCurve(splineCurves.Position);
+	hashCurve(splineCurves.Rotation);
+	hashCurve(splineCurves.Scale);
+	return hash;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+bool URyRuntimeComponentHelpers::UpdateSplineDistanceTable(USplineComponent* splineComponent, FRySplineDistanceTable& table,
+                                                           const float sampleSpacing, const bool forceRebuild)
+{
+	if(!splineComponent)
+	{
+		UE_LOG(LogRyRuntime, Warning, TEXT("UpdateSplineDistanceTable called with null splineComponent!"));
+		return false;
+	}
+
+	const float spacing = FMath::Max(sampleSpacing, 0.01f);
+	const uint32 splineHash = HashSplineCurves(splineComponent);
+	if(!forceRebuild && table.IsBuilt() && table.Spline.Get() == splineComponent && table.SplineHash == splineHash && table.SampleSpacing == spacing)
+	{
+		return false;
+	}
+
+	table.Spline = splineComponent;
+	table.SplineHash = splineHash;
+	table.SampleSpacing = spacing;
+	table.ClosedLoop = splineComponent->IsClosedLoop();
+	table.Distances.Reset();
+	table.Locations.Reset();
+	table.Tangents.Reset();
+	table.Rotations.Reset();
+
+	// GetDistanceAlongSplineAtSplinePoint reads the reparam table, which UpdateSpline fills
+	const FInterpCurveFloat& reparamTable = splineComponent->SplineCurves.ReparamTable;
+	if(splineComponent->GetNumberOfSplinePoints() < 2 || reparamTable.Points.Num() == 0)
+	{
+		return true;
+	}
+
+	// Subdivide each segment in proportion to its own length, so long segments are sampled as densely as short ones
+	const int32 MaxSamples = 1 << 20;
+	const int32 numSegments = table.ClosedLoop ? splineComponent->GetNumberOfSplinePoints() : splineComponent->GetNumberOfSplinePoints() - 1;
+	TArray<int32> segmentSteps;
+	segmentSteps.SetNumUninitialized(numSegments);
+	int64 numSteps = 0;
+	float segmentStart = splineComponent->GetDistanceAlongSplineAtSplinePoint(0);
+	for(int32 segmentIndex = 0; segmentIndex < numSegments; ++segmentIndex)
+	{
+		const float segmentEnd = splineComponent->GetDistanceAlongSplineAtSplinePoint(segmentIndex + 1);
+		segmentSteps[segmentIndex] = FMath::Max(FMath::CeilToInt(FMath::Min((segmentEnd - segmentStart) / spacing, static_cast<float>(MaxSamples))), 1);
+		numSteps += segmentSteps[segmentIndex];
+		segmentStart = segmentEnd;
+	}
+
+	// Too many samples, thin every segment alike
+	if(numSteps >= MaxSamples)
+	{
+		const double thinning = static_cast<double>(MaxSamples - 1 - numSegments) / numSteps;
+		numSteps = 0;
+		for(int32& steps : segmentSteps)
+		{
+			steps = FMath::Max(static_cast<int32>(steps * thinning), 1);
+			numSteps += steps;
+		}
+	}
+
+	const int32 numSamples = static_cast<int32>(numSteps) + 1;
+	table.Distances.SetNumUninitialized(numSamples);
+	table.Locations.SetNumUninitialized(numSamples);
+	table.Tangents.SetNumUninitialized(numSamples);
+	table.Rotations.SetNumUninitialized(numSamples);
+
+	float distance = 0.0f;
+	int32 sampleIndex = 0;
+	auto addSample = [splineComponent, &table, &distance, &sampleIndex](const float inputKey)
+	{
+		const FVector location = splineComponent->GetLocationAtSplineInputKey(inputKey, ESplineCoordinateSpace::Local);
+		if(sampleIndex > 0)
+		{
+			distance += FVector::Dist(table.Locations[sampleIndex - 1], location);
+		}
+		table.Distances[sampleIndex] = distance;
+		table.Locations[sampleIndex] = location;
+		table.Tangents[sampleIndex] = splineComponent->GetTangentAtSplineInputKey(inputKey, ESplineCoordinateSpace::Local);
+		table.Rotations[sampleIndex] = splineComponent->GetQuaternionAtSplineInputKey(inputKey, ESplineCoordinateSpace::Local);
+		++sampleIndex;
+	};
+
+	// Segment n spans input keys n to n + 1
+	addSample(0.0f);
+	for(int32 segmentIndex = 0; segmentIndex < numSegments; ++segmentIndex)
+	{
+		const int32 steps = segmentSteps[segmentIndex];
+		for(int32 step = 1; step <= steps; ++step)
+		{
+			addSample(segmentIndex + static_cast<float>(step) / steps);
+		}
+	}
+	check(sampleIndex == numSamples);
+	return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * The transform taking table samples to coordinateSpace
+*/
+static FTransform GetSplineDistanceTableTransform(const FRySplineDistanceTable& table, ESplineCoordinateSpace::Type coordinateSpace)
+{
+	if(coordinateSpace == ESplineCoordinateSpace::World)
+	{
+		if(const USplineComponent* splineComponent = table.Spline.Get())
+		{
+			return splineComponent->GetComponentTransform();
+		}
+		UE_LOG(LogRyRuntime, Warning, TEXT("SampleSplineDistanceTable: The table's spline is gone, returning local space"));
+	}
+	return FTransform::Identity;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeComponentHelpers::SampleSplineDistanceTable(const FRySplineDistanceTable& table, const float distance, ESplineCoordinateSpace::Type coordinateSpace,
+                                                           FVector& location, FRotator& rotation, FVector& tangent)
+{
+	FQuat quat;
+	table.Sample(distance, location, quat, tangent);
+	if(coordinateSpace == ESplineCoordinateSpace::World)
+	{
+		const FTransform transform = GetSplineDistanceTableTransform(table, coordinateSpace);
+		location = transform.TransformPosition(location);
+		tangent = transform.TransformVector(tangent);
+		quat = transform.GetRotation() * quat;
+	}
+	rotation = quat.Rotator();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeComponentHelpers::SampleSplineDistanceTableBatch(const FRySplineDistanceTable& table, const TArray<float>& distances,
+                                                                ESplineCoordinateSpace::Type coordinateSpace, TArray<FTransform>& transformsOut)
+{
+	const FTransform transform = GetSplineDistanceTableTransform(table, coordinateSpace);
+	const FQuat spaceRotation = transform.GetRotation();
+	const FVector spaceScale = transform.GetScale3D();
+
+	transformsOut.SetNumUninitialized(distances.Num());
+	for(int32 distanceIndex = 0; distanceIndex < distances.Num(); ++distanceIndex)
+	{
+		FVector location, tangent;
+		FQuat rotation;
+		table.Sample(distances[distanceIndex], location, rotation, tangent);
+		transformsOut[distanceIndex] = FTransform(spaceRotation * rotation, transform.TransformPosition(location), spaceScale);
+	}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * Shared by CopyCollisionProperties and ConvertStaticMeshesToInstances
+*/
+static void ApplyCollisionProperties(const UPrimitiveComponent* sourceMesh, UPrimitiveComponent* destMesh)
+{
 	destMesh->SetGenerateOverlapEvents(sourceMesh->GetGenerateOverlapEvents());
 	destMesh->SetCollisionProfileName(sourceMesh->GetCollisionProfileName());
 	destMesh->SetCollisionEnabled(sourceMesh->GetCollisionEnabled());
@@ -113,6 +729,19 @@ void URyRuntimeComponentHelpers::CopyCollisionProperties(UPrimitiveComponent* so
 #endif
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeComponentHelpers::CopyCollisionProperties(UPrimitiveComponent* sourceMesh, UPrimitiveComponent* destMesh)
+{
+	if(!sourceMesh || !destMesh)
+	{
+		return;
+	}
+
+	ApplyCollisionProperties(sourceMesh, destMesh);
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 /**
 */
@@ -128,3 +757,277 @@ void URyRuntimeComponentHelpers::CopyMaterials(UPrimitiveComponent* sourceMesh,
 		destMesh->SetMaterial(matIndex, sourceMesh->GetMaterial(matIndex));
 	}
 }
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+FRyComponentBatchStats URyRuntimeComponentHelpers::CopyCollisionPropertiesBatch(UPrimitiveComponent* sourceMesh, const TArray<UPrimitiveComponent*>& destMeshes)
+{
+	const double startTime = FPlatformTime::Seconds();
+	FRyComponentBatchStats stats;
+	if(!sourceMesh)
+	{
+		UE_LOG(LogRyRuntime, Warning, TEXT("CopyCollisionPropertiesBatch called with null sourceMesh!"));
+		return stats;
+	}
+
+	// Read the source once
+	const bool generateOverlapEvents = sourceMesh->GetGenerateOverlapEvents();
+	const FName collisionProfileName = sourceMesh->GetCollisionProfileName();
+	const ECollisionEnabled::Type collisionEnabled = sourceMesh->GetCollisionEnabled();
+	const bool canEverAffectNavigation = sourceMesh->CanEverAffectNavigation();
+
+	// Overlaps are updated once per changed profile after every component has its new settings, so overlap events
+	// don't run (and see half copied settings) between components
+	TArray<UPrimitiveComponent*, TInlineAllocator<64>> updateOverlaps;
+	for(UPrimitiveComponent* destMesh : destMeshes)
+	{
+		if(!destMesh)
+		{
+			++stats.NumSkipped;
+			continue;
+		}
+
+		++stats.NumComponents;
+
+		// Each setter updates the physics bodies, overlaps or navigation, so only call the ones with something to change
+		const bool overlapDiffers = destMesh->GetGenerateOverlapEvents() != generateOverlapEvents;
+		const bool profileDiffers = destMesh->GetCollisionProfileName() != collisionProfileName;
+		const bool enabledDiffers = destMesh->GetCollisionEnabled() != collisionEnabled;
+		const bool navigationDiffers = destMesh->CanEverAffectNavigation() != canEverAffectNavigation;
+		if(!overlapDiffers && !profileDiffers && !enabledDiffers && !navigationDiffers)
+		{
+			continue;
+		}
+
+#if WITH_EDITOR
+		if(destMesh->CanModify())
+		{
+			destMesh->Modify();
+		}
+#endif
+		if(overlapDiffers)
+		{
+			destMesh->SetGenerateOverlapEvents(generateOverlapEvents);
+		}
+		if(profileDiffers)
+		{
+			destMesh->SetCollisionProfileName(collisionProfileName, false);
+			if(destMesh->IsRegistered())
+			{
+				updateOverlaps.Add(destMesh);
+			}
+		}
+		// The profile may have set the collision enabled state already
+		if(destMesh->GetCollisionEnabled() != collisionEnabled)
+		{
+			destMesh->SetCollisionEnabled(collisionEnabled);
+		}
+		if(navigationDiffers)
+		{
+			destMesh->SetCanEverAffectNavigation(canEverAffectNavigation);
+		}
+		++stats.NumChanged;
+	}
+
+	for(UPrimitiveComponent* destMesh : updateOverlaps)
+	{
+		// Overlap events of earlier components may have destroyed it
+		if(IsValid(destMesh) && destMesh->IsRegistered())
+		{
+			destMesh->UpdateOverlaps();
+		}
+	}
+
+	stats.Milliseconds = static_cast<float>((FPlatformTime::Seconds() - startTime) * 1000.0);
+	return stats;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+FRyComponentBatchStats URyRuntimeComponentHelpers::CopyMaterialsBatch(UPrimitiveComponent* sourceMesh, const TArray<UPrimitiveComponent*>& destMeshes)
+{
+	const double startTime = FPlatformTime::Seconds();
+	FRyComponentBatchStats stats;
+	if(!sourceMesh)
+	{
+		UE_LOG(LogRyRuntime, Warning, TEXT("CopyMaterialsBatch called with null sourceMesh!"));
+		return stats;
+	}
+
+	// Read the source once
+	TArray<UMaterialInterface*, TInlineAllocator<16>> sourceMaterials;
+	for(int32 matIndex = 0; matIndex < sourceMesh->GetNumMaterials(); ++matIndex)
+	{
+		sourceMaterials.Add(sourceMesh->GetMaterial(matIndex));
+	}
+
+	for(UPrimitiveComponent* destMesh : destMeshes)
+	{
+		if(!destMesh)
+		{
+			++stats.NumSkipped;
+			continue;
+		}
+
+		++stats.NumComponents;
+		bool changed = false;
+		const int32 numMaterials = FMath::Min(sourceMaterials.Num(), destMesh->GetNumMaterials());
+		for(int32 matIndex = 0; matIndex < numMaterials; ++matIndex)
+		{
+			if(destMesh->GetMaterial(matIndex) != sourceMaterials[matIndex])
+			{
+				destMesh->SetMaterial(matIndex, sourceMaterials[matIndex]);
+				changed = true;
+			}
+		}
+		stats.NumChanged += changed ? 1 : 0;
+	}
+
+	stats.Milliseconds = static_cast<float>((FPlatformTime::Seconds() - startTime) * 1000.0);
+	return stats;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * What must match for static mesh components to share an instanced component
+*/
+struct FRyInstanceGroupKey
+{
+	UStaticMesh* Mesh = nullptr;
+	TArray<UMaterialInterface*, TInlineAllocator<8>> Materials;
+	FName CollisionProfileName;
+	ECollisionEnabled::Type CollisionEnabled = ECollisionEnabled::NoCollision;
+	EComponentMobility::Type Mobility = EComponentMobility::Static;
+	bool GenerateOverlapEvents = false;
+	bool CanEverAffectNavigation = false;
+	bool CastShadow = false;
+
+	explicit FRyInstanceGroupKey(const UStaticMeshComponent* component)
+		: Mesh(component->GetStaticMesh())
+		, CollisionProfileName(component->GetCollisionProfileName())
+		, CollisionEnabled(component->GetCollisionEnabled())
+		, Mobility(component->Mobility)
+		, GenerateOverlapEvents(component->GetGenerateOverlapEvents())
+		, CanEverAffectNavigation(component->CanEverAffectNavigation())
+		, CastShadow(component->CastShadow)
+	{
+		for(int32 matIndex = 0; matIndex < component->GetNumMaterials(); ++matIndex)
+		{
+			Materials.Add(component->GetMaterial(matIndex));
+		}
+	}
+
+	bool operator==(const FRyInstanceGroupKey& other) const
+	{
+		return Mesh == other.Mesh && Materials == other.Materials && CollisionProfileName == other.CollisionProfileName
+			&& CollisionEnabled == other.CollisionEnabled && Mobility == other.Mobility && GenerateOverlapEvents == other.GenerateOverlapEvents
+			&& CanEverAffectNavigation == other.CanEverAffectNavigation && CastShadow == other.CastShadow;
+	}
+
+	friend uint32 GetTypeHash(const FRyInstanceGroupKey& key)
+	{
+		uint32 hash = HashCombine(GetTypeHash(key.Mesh), GetTypeHash(key.CollisionProfileName));
+		for(const UMaterialInterface* material : key.Materials)
+		{
+			hash = HashCombine(hash, GetTypeHash(material));
+		}
+		return HashCombine(hash, (key.CollisionEnabled << 8) | (key.Mobility << 4) | (key.GenerateOverlapEvents << 2)
+			| (key.CanEverAffectNavigation << 1) | static_cast<uint32>(key.CastShadow));
+	}
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+FRyInstancingStats URyRuntimeComponentHelpers::ConvertStaticMeshesToInstances(AActor* instanceOwner, const TArray<UStaticMeshComponent*>& components,
+                                                                               const bool destroySourceComponents,
+                                                                               TArray<UHierarchicalInstancedStaticMeshComponent*>& instancedComponentsOut)
+{
+	const double startTime = FPlatformTime::Seconds();
+	FRyInstancingStats stats;
+	instancedComponentsOut.Reset();
+	if(!instanceOwner)
+	{
+		UE_LOG(LogRyRuntime, Warning, TEXT("ConvertStaticMeshesToInstances called with null instanceOwner!"));
+		return stats;
+	}
+
+	// The owner's root stays, the instanced components attach to it
+	USceneComponent* rootComponent = instanceOwner->GetRootComponent();
+	TMap<FRyInstanceGroupKey, TArray<UStaticMeshComponent*>> groups;
+	for(UStaticMeshComponent* component : components)
+	{
+		if(!component || component == rootComponent || !component->GetStaticMesh() || component->IsA<UInstancedStaticMeshComponent>()
+		   || component->IsSimulatingPhysics())
+		{
+			++stats.NumSkipped;
+			continue;
+		}
+		groups.FindOrAdd(FRyInstanceGroupKey(component)).Add(component);
+	}
+
+	// Instances are added before the new component is registered, so the tree is built once rather than per instance
+	const FTransform ownerTransform = rootComponent ? rootComponent->GetComponentTransform() : FTransform::Identity;
+	TArray<FTransform> instanceTransforms;
+	for(const TPair<FRyInstanceGroupKey, TArray<UStaticMeshComponent*>>& group : groups)
+	{
+		const FRyInstanceGroupKey& key = group.Key;
+		const TArray<UStaticMeshComponent*>& groupComponents = group.Value;
+		const int32 numSections = key.Mesh->GetNumSections(0);
+
+		UHierarchicalInstancedStaticMeshComponent* instancedComponent = NewObject<UHierarchicalInstancedStaticMeshComponent>(instanceOwner);
+		instancedComponent->SetMobility(key.Mobility);
+		instancedComponent->SetStaticMesh(key.Mesh);
+		for(int32 matIndex = 0; matIndex < key.Materials.Num(); ++matIndex)
+		{
+			instancedComponent->SetMaterial(matIndex, key.Materials[matIndex]);
+		}
+		instancedComponent->SetCastShadow(key.CastShadow);
+		ApplyCollisionProperties(groupComponents[0], instancedComponent);
+
+		instanceTransforms.Reset(groupComponents.Num());
+		for(UStaticMeshComponent* component : groupComponents)
+		{
+			instanceTransforms.Add(component->GetComponentTransform().GetRelativeTransform(ownerTransform));
+		}
+		instancedComponent->AddInstances(instanceTransforms, false);
+
+		if(rootComponent)
+		{
+			instancedComponent->SetupAttachment(rootComponent);
+		}
+		else
+		{
+			instanceOwner->SetRootComponent(instancedComponent);
+			rootComponent = instancedComponent;
+		}
+		instanceOwner->AddInstanceComponent(instancedComponent);
+		instancedComponent->RegisterComponent();
+		instancedComponentsOut.Add(instancedComponent);
+
+		for(UStaticMeshComponent* component : groupComponents)
+		{
+			if(destroySourceComponents)
+			{
+				component->DestroyComponent();
+			}
+			else
+			{
+				component->SetVisibility(false);
+				component->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+			}
+		}
+
+		stats.NumConverted += groupComponents.Num();
+		stats.DrawCallsBefore += groupComponents.Num() * numSections;
+		stats.DrawCallsAfter += numSections;
+	}
+
+	stats.NumInstancedComponents = instancedComponentsOut.Num();
+	stats.Milliseconds = static_cast<float>((FPlatformTime::Seconds() - startTime) * 1000.0);
+	UE_LOG(LogRyRuntime, Log, TEXT("ConvertStaticMeshesToInstances: %d components into %d instanced components, draw calls %d -> %d in %.2fms"),
+	       stats.NumConverted, stats.NumInstancedComponents, stats.DrawCallsBefore, stats.DrawCallsAfter, stats.Milliseconds);
+	return stats;
+}
@@ -0,0 +1,212 @@
+// Copyright 2020-2021 Sheffer Online Services.
+// MIT License. See LICENSE for details.
+
+#include "RyRuntimeComponentPoolSubsystem.h"
+#include "RyRuntimeModule.h"
+#include "RyRuntimeLevelHelpers.h"
+#include "Components/SceneComponent.h"
+#include "GameFramework/Actor.h"
+
+DECLARE_CYCLE_STAT(TEXT("ComponentPool Acquire"), STAT_RyComponentPoolAcquire, STATGROUP_RyRuntime);
+DECLARE_CYCLE_STAT(TEXT("ComponentPool Release"), STAT_RyComponentPoolRelease, STATGROUP_RyRuntime);
+DECLARE_DWORD_COUNTER_STAT(TEXT("ComponentPool Num Pooled"), STAT_RyComponentPoolNumPooled, STATGROUP_RyRuntime);
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeComponentPoolSubsystem::Deinitialize()
+{
+    ClearPool();
+    Super::Deinitialize();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+UActorComponent* URyRuntimeComponentPoolSubsystem::AcquireComponent(AActor* owner, TSubclassOf<UActorComponent> componentClass,
+                                                                   USceneComponent* attachComponent)
+{
+    SCOPE_CYCLE_COUNTER(STAT_RyComponentPoolAcquire);
+
+    if(!componentClass)
+    {
+        UE_LOG(LogRyRuntime, Warning, TEXT("AcquireComponent: Invalid componentClass"));
+        return nullptr;
+    }
+
+    if(!owner && attachComponent)
+    {
+        owner = attachComponent->GetOwner();
+    }
+    if(!owner)
+    {
+        UE_LOG(LogRyRuntime, Warning, TEXT("AcquireComponent: No owner for %s"), *componentClass->GetName());
+        return nullptr;
+    }
+
+    // Pop until a live component turns up, pooled components can still be destroyed by e.g. world cleanup
+    UActorComponent* component = nullptr;
+    if(FRyComponentPoolEntry* pool = Pools.Find(componentClass))
+    {
+        while(!component && pool->Components.Num() > 0)
+        {
+            UActorComponent* pooledComponent = pool->Components.Pop(false);
+            --Stats.NumPooled;
+            if(IsValid(pooledComponent))
+            {
+                component = pooledComponent;
+            }
+        }
+    }
+
+    ++Stats.NumAcquired;
+    if(!component)
+    {
+        ++Stats.NumCreated;
+        SET_DWORD_STAT(STAT_RyComponentPoolNumPooled, Stats.NumPooled);
+        return URyRuntimeLevelHelpers::CreateComponentForActor(owner, componentClass, attachComponent);
+    }
+
+    ++Stats.NumReused;
+    SET_DWORD_STAT(STAT_RyComponentPoolNumPooled, Stats.NumPooled);
+
+    // Same setup as CreateComponentForActor, but into the existing object
+    MoveComponentTo(component, owner);
+    if(attachComponent)
+    {
+        if(USceneComponent* sceneComponent = Cast<USceneComponent>(component))
+        {
+            sceneComponent->AttachToComponent(attachComponent, FAttachmentTransformRules::SnapToTargetIncludingScale);
+        }
+    }
+    component->RegisterComponent();
+    return component;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+bool URyRuntimeComponentPoolSubsystem::ReleaseComponent(UActorComponent* component)
+{
+    SCOPE_CYCLE_COUNTER(STAT_RyComponentPoolRelease);
+
+    if(!IsValid(component))
+    {
+        return false;
+    }
+
+    FRyComponentPoolEntry& pool = Pools.FindOrAdd(component->GetClass());
+    if(pool.Components.Contains(component))
+    {
+        UE_LOG(LogRyRuntime, Warning, TEXT("ReleaseComponent: %s is already pooled"), *component->GetName());
+        return true;
+    }
+
+    if(pool.Components.Num() >= MaxPooledPerClass)
+    {
+        ++Stats.NumDestroyed;
+        component->DestroyComponent();
+        return false;
+    }
+
+    if(component->IsActive())
+    {
+        component->Deactivate();
+    }
+    if(USceneComponent* sceneComponent = Cast<USceneComponent>(component))
+    {
+        sceneComponent->DetachFromComponent(FDetachmentTransformRules::KeepRelativeTransform);
+    }
+    if(component->IsRegistered())
+    {
+        component->UnregisterComponent();
+    }
+
+    // Out of the owner, so it isn't destroyed along with it
+    MoveComponentTo(component, this);
+
+    pool.Components.Add(component);
+    ++Stats.NumReleased;
+    ++Stats.NumPooled;
+    SET_DWORD_STAT(STAT_RyComponentPoolNumPooled, Stats.NumPooled);
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeComponentPoolSubsystem::PrewarmPool(TSubclassOf<UActorComponent> componentClass, const int32 numComponents)
+{
+    if(!componentClass)
+    {
+        UE_LOG(LogRyRuntime, Warning, TEXT("PrewarmPool: Invalid componentClass"));
+        return;
+    }
+
+    FRyComponentPoolEntry& pool = Pools.FindOrAdd(componentClass);
+    const int32 numToCreate = FMath::Min(numComponents, MaxPooledPerClass) - pool.Components.Num();
+    for(int32 index = 0; index < numToCreate; ++index)
+    {
+        pool.Components.Add(NewObject<UActorComponent>(this, componentClass));
+    }
+    Stats.NumPooled += FMath::Max(numToCreate, 0);
+    SET_DWORD_STAT(STAT_RyComponentPoolNumPooled, Stats.NumPooled);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeComponentPoolSubsystem::ClearPool()
+{
+    for(TPair<UClass*, FRyComponentPoolEntry>& pool : Pools)
+    {
+        for(UActorComponent* component : pool.Value.Components)
+        {
+            if(IsValid(component))
+            {
+                component->DestroyComponent();
+            }
+        }
+    }
+    Pools.Reset();
+    Stats.NumPooled = 0;
+    SET_DWORD_STAT(STAT_RyComponentPoolNumPooled, 0);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+int32 URyRuntimeComponentPoolSubsystem::GetNumPooled(TSubclassOf<UActorComponent> componentClass) const
+{
+    const FRyComponentPoolEntry* pool = Pools.Find(componentClass);
+    return pool ? pool->Components.Num() : 0;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeComponentPoolSubsystem::ResetPoolStats()
+{
+    const int32 numPooled = Stats.NumPooled;
+    Stats = FRyComponentPoolStats();
+    Stats.NumPooled = numPooled;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeComponentPoolSubsystem::MoveComponentTo(UActorComponent* component, UObject* newOuter)
+{
+    if(component->GetOuter() == newOuter)
+    {
+        return;
+    }
+
+    // Renaming into an actor also moves the component between the old and new owner's component lists
+    FName newName = component->GetFName();
+    if(StaticFindObjectFast(nullptr, newOuter, newName))
+    {
+        newName = MakeUniqueObjectName(newOuter, component->GetClass(), newName);
+    }
+    component->Rename(*newName.ToString(), newOuter, REN_DontCreateRedirectors | REN_ForceNoResetLoaders | REN_NonTransactional | REN_DoNotDirty);
+}
@@ -3,6 +3,7 @@
 
 #include "RyRuntimeLevelHelpers.h"
 #include "RyRuntimeModule.h"
+#include "RyRuntimeLevelNameCacheSubsystem.h"
 #include "Kismet/GameplayStatics.h"
 #include "Misc/PackageName.h"
 #include "Engine/Level.h"
@@ -11,6 +12,7 @@
 #include "Engine/LevelStreaming.h"
 #include "Engine/LevelStreamingDynamic.h"
 #include "Engine/LevelScriptActor.h"
+#include "Components/SceneComponent.h"
 
 //---------------------------------------------------------------------------------------------------------------------
 /**
@@ -160,6 +162,34 @@ UObject* URyRuntimeLevelHelpers::FindObjectInLevelByName(ULevel* levelToSearch,
     return StaticFindObject(/*Class=*/ nullptr, levelToSearch, *nameToFind, true);
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeLevelHelpers::FindObjectsInLevelByNames(ULevel* levelToSearch, const TArray<FString>& namesToFind, TArray<UObject*>& objectsOut)
+{
+    if(!levelToSearch)
+    {
+        UE_LOG(LogRyRuntime, Warning, TEXT("RyRuntimeLevelHelpers::FindObjectsInLevelByNames error. levelToSearch is NULL!"));
+        objectsOut.Init(nullptr, namesToFind.Num());
+        return;
+    }
+
+    UWorld* world = levelToSearch->GetWorld();
+    URyRuntimeLevelNameCacheSubsystem* nameCache = world ? world->GetSubsystem<URyRuntimeLevelNameCacheSubsystem>() : nullptr;
+    if(nameCache)
+    {
+        nameCache->FindObjectsInLevel(levelToSearch, namesToFind, objectsOut);
+        return;
+    }
+
+    // No world to cache with, resolve one at a time
+    objectsOut.SetNumUninitialized(namesToFind.Num());
+    for(int32 nameIndex = 0; nameIndex < namesToFind.Num(); ++nameIndex)
+    {
+        objectsOut[nameIndex] = FindObjectInLevelByName(levelToSearch, namesToFind[nameIndex]);
+    }
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 /**
 */
@@ -346,6 +376,59 @@ bool URyRuntimeLevelHelpers::TeleportToAdvanced(AActor* ActorToTeleport, const F
     return ActorToTeleport->TeleportTo(DestLocation, DestRotation, IsATest, NoCheck);
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+int32 URyRuntimeLevelHelpers::TeleportActorsAdvanced(const TArray<AActor*>& ActorsToTeleport, const TArray<FVector>& DestLocations,
+                                                     const TArray<FRotator>& DestRotations, TArray<bool>& SuccessOut, bool IsATest, bool NoCheck)
+{
+    SuccessOut.Init(false, ActorsToTeleport.Num());
+
+    if(DestLocations.Num() != ActorsToTeleport.Num() || DestRotations.Num() != ActorsToTeleport.Num())
+    {
+        UE_LOG(LogRyRuntime, Warning, TEXT("RyRuntimeLevelHelpers::TeleportActorsAdvanced error. DestLocations and DestRotations must be aligned to ActorsToTeleport!"));
+        return 0;
+    }
+
+    int32 numMoved = 0;
+    {
+        // Open a deferred movement scope on every root component so overlaps and physics are only committed once all
+        // actors are in their new places. Scopes must close in reverse order, which TIndirectArray gives us below.
+        TIndirectArray<FScopedMovementUpdate> movementScopes;
+        movementScopes.Reserve(ActorsToTeleport.Num());
+        for(AActor* actor : ActorsToTeleport)
+        {
+            USceneComponent* rootComponent = actor ? actor->GetRootComponent() : nullptr;
+            if(rootComponent && !rootComponent->IsDeferringMovementUpdates())
+            {
+                movementScopes.Add(new FScopedMovementUpdate(rootComponent, EScopedUpdate::DeferredUpdates));
+            }
+        }
+
+        for(int32 actorIndex = 0; actorIndex < ActorsToTeleport.Num(); ++actorIndex)
+        {
+            AActor* actor = ActorsToTeleport[actorIndex];
+            if(!actor || actor->IsPendingKill())
+            {
+                continue;
+            }
+
+            SuccessOut[actorIndex] = actor->TeleportTo(DestLocations[actorIndex], DestRotations[actorIndex], IsATest, NoCheck);
+            if(SuccessOut[actorIndex])
+            {
+                ++numMoved;
+            }
+        }
+
+        while(movementScopes.Num())
+        {
+            movementScopes.RemoveAt(movementScopes.Num() - 1);
+        }
+    }
+
+    return numMoved;
+}
+
 int32 URyRuntimeLevelHelpers::UniqueLevelInstanceId = 0;
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,220 @@
+// Copyright 2020-2021 Sheffer Online Services.
+// MIT License. See LICENSE for details.
+
+#include "RyRuntimeLevelNameCacheSubsystem.h"
+#include "RyRuntimeModule.h"
+#include "Engine/Engine.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "UObject/UObjectHash.h"
+
+DECLARE_CYCLE_STAT(TEXT("LevelNameCache Build"), STAT_RyLevelNameCacheBuild, STATGROUP_RyRuntime);
+DECLARE_CYCLE_STAT(TEXT("LevelNameCache Resolve"), STAT_RyLevelNameCacheResolve, STATGROUP_RyRuntime);
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeLevelNameCacheSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    if(UWorld* world = GetWorld())
+    {
+        ActorSpawnedHandle = world->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &URyRuntimeLevelNameCacheSubsystem::OnActorSpawned));
+    }
+    if(GEngine)
+    {
+        LevelActorDeletedHandle = GEngine->OnLevelActorDeleted().AddUObject(this, &URyRuntimeLevelNameCacheSubsystem::OnLevelActorDeleted);
+    }
+    LevelRemovedFromWorldHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &URyRuntimeLevelNameCacheSubsystem::OnLevelRemovedFromWorld);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeLevelNameCacheSubsystem::Deinitialize()
+{
+    if(UWorld* world = GetWorld())
+    {
+        world->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+    }
+    if(GEngine)
+    {
+        GEngine->OnLevelActorDeleted().Remove(LevelActorDeletedHandle);
+    }
+    FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedFromWorldHandle);
+
+    LevelNameMaps.Reset();
+    Super::Deinitialize();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+UObject* URyRuntimeLevelNameCacheSubsystem::FindObjectInLevel(ULevel* levelToSearch, const FString& nameToFind)
+{
+    if(!levelToSearch)
+    {
+        return nullptr;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_RyLevelNameCacheResolve);
+    return FindInNameMap(levelToSearch, GetLevelNameMap(levelToSearch), nameToFind);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeLevelNameCacheSubsystem::FindObjectsInLevel(ULevel* levelToSearch, const TArray<FString>& namesToFind, TArray<UObject*>& objectsOut)
+{
+    objectsOut.Init(nullptr, namesToFind.Num());
+    if(!levelToSearch)
+    {
+        return;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_RyLevelNameCacheResolve);
+    FLevelNameMap& nameMap = GetLevelNameMap(levelToSearch);
+    for(int32 nameIndex = 0; nameIndex < namesToFind.Num(); ++nameIndex)
+    {
+        objectsOut[nameIndex] = FindInNameMap(levelToSearch, nameMap, namesToFind[nameIndex]);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeLevelNameCacheSubsystem::InvalidateLevel(ULevel* level)
+{
+    LevelNameMaps.Remove(level);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeLevelNameCacheSubsystem::InvalidateAllLevels()
+{
+    LevelNameMaps.Reset();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+URyRuntimeLevelNameCacheSubsystem::FLevelNameMap& URyRuntimeLevelNameCacheSubsystem::GetLevelNameMap(ULevel* level)
+{
+    if(FLevelNameMap* existingMap = LevelNameMaps.Find(level))
+    {
+        return *existingMap;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_RyLevelNameCacheBuild);
+
+    // Level-outered objects only, which is what StaticFindObject with the level as outer would see
+    FLevelNameMap& nameMap = LevelNameMaps.Add(level);
+    ForEachObjectWithOuter(level, [&nameMap](UObject* object)
+    {
+        if(!object->IsPendingKill())
+        {
+            nameMap.Add(object->GetFName(), object);
+        }
+    }, false);
+    return nameMap;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+UObject* URyRuntimeLevelNameCacheSubsystem::FindInNameMap(ULevel* level, FLevelNameMap& nameMap, const FString& nameToFind)
+{
+    int32 dotIndex;
+    if(nameToFind.FindChar(TEXT('.'), dotIndex) || nameToFind.FindChar(TEXT(':'), dotIndex))
+    {
+        // Sub object paths are resolved by the object system
+        return StaticFindObject(/*Class=*/ nullptr, level, *nameToFind, true);
+    }
+
+    // If the name was never created, there can't be an object with it
+    const FName name(*nameToFind, FNAME_Find);
+    if(name.IsNone())
+    {
+        return nullptr;
+    }
+
+    if(TWeakObjectPtr<UObject>* cachedObject = nameMap.Find(name))
+    {
+        UObject* object = cachedObject->Get();
+        if(object && !object->IsPendingKill() && object->GetOuter() == level && object->GetFName() == name)
+        {
+            return object;
+        }
+    }
+
+    // Missing or stale (renamed, destroyed, not an actor so not tracked). Ask the object system and remember the answer.
+    UObject* object = StaticFindObject(/*Class=*/ nullptr, level, *nameToFind, true);
+    if(object)
+    {
+        nameMap.Add(name, object);
+    }
+    else
+    {
+        nameMap.Remove(name);
+    }
+    return object;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeLevelNameCacheSubsystem::OnActorSpawned(AActor* spawnedActor)
+{
+    if(!spawnedActor)
+    {
+        return;
+    }
+
+    if(FLevelNameMap* nameMap = LevelNameMaps.Find(spawnedActor->GetLevel()))
+    {
+        nameMap->Add(spawnedActor->GetFName(), spawnedActor);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeLevelNameCacheSubsystem::OnLevelActorDeleted(AActor* deletedActor)
+{
+    if(!deletedActor)
+    {
+        return;
+    }
+
+    if(FLevelNameMap* nameMap = LevelNameMaps.Find(deletedActor->GetLevel()))
+    {
+        const TWeakObjectPtr<UObject>* cachedObject = nameMap->Find(deletedActor->GetFName());
+        if(cachedObject && cachedObject->Get() == deletedActor)
+        {
+            nameMap->Remove(deletedActor->GetFName());
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeLevelNameCacheSubsystem::OnLevelRemovedFromWorld(ULevel* level, UWorld* world)
+{
+    if(world != GetWorld())
+    {
+        return;
+    }
+
+    if(level)
+    {
+        InvalidateLevel(level);
+    }
+    else
+    {
+        // A null level means every level was removed
+        InvalidateAllLevels();
+    }
+}
@@ -0,0 +1,333 @@
+// Copyright 2020-2021 Sheffer Online Services.
+// MIT License. See LICENSE for details.
+
+#include "RyRuntimeMaterialCacheSubsystem.h"
+#include "RyRuntimeModule.h"
+#include "Components/PrimitiveComponent.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Engine/Texture.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("MaterialCache Num Shared Materials"), STAT_RyMaterialCacheNumShared, STATGROUP_RyRuntime);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("MaterialCache Instances Created"), STAT_RyMaterialCacheCreated, STATGROUP_RyRuntime);
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * Bits of a parameter value for hashing and comparing, with -0 folded into +0 and every NaN into one NaN, so values
+ * which set the same material state hash and compare the same
+*/
+static uint32 GetCanonicalBits(const float value)
+{
+    if(value == 0.0f)
+    {
+        return 0;
+    }
+    if(FMath::IsNaN(value))
+    {
+        return 0x7fc00000;
+    }
+    uint32 bits;
+    FMemory::Memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+static uint32 GetCanonicalHash(const FLinearColor& value)
+{
+    return HashCombine(HashCombine(GetCanonicalBits(value.R), GetCanonicalBits(value.G)), HashCombine(GetCanonicalBits(value.B), GetCanonicalBits(value.A)));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+static bool CanonicalEqual(const FLinearColor& a, const FLinearColor& b)
+{
+    return GetCanonicalBits(a.R) == GetCanonicalBits(b.R) && GetCanonicalBits(a.G) == GetCanonicalBits(b.G)
+        && GetCanonicalBits(a.B) == GetCanonicalBits(b.B) && GetCanonicalBits(a.A) == GetCanonicalBits(b.A);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * Order independent map comparison, using valuesEqual for the values
+*/
+template<typename ValueType, typename EqualType>
+static bool ParameterMapsEqual(const TMap<FName, ValueType>& a, const TMap<FName, ValueType>& b, EqualType valuesEqual)
+{
+    if(a.Num() != b.Num())
+    {
+        return false;
+    }
+    for(const TPair<FName, ValueType>& parameter : a)
+    {
+        const ValueType* otherValue = b.Find(parameter.Key);
+        if(!otherValue || !valuesEqual(parameter.Value, *otherValue))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+uint32 FRyMaterialParameterSet::GetHash() const
+{
+    // Summing the entry hashes makes the result independent of map order
+    uint32 scalarHash = 0;
+    for(const TPair<FName, float>& parameter : ScalarParameters)
+    {
+        scalarHash += HashCombine(GetTypeHash(parameter.Key), GetCanonicalBits(parameter.Value));
+    }
+
+    uint32 vectorHash = 0;
+    for(const TPair<FName, FLinearColor>& parameter : VectorParameters)
+    {
+        vectorHash += HashCombine(GetTypeHash(parameter.Key), GetCanonicalHash(parameter.Value));
+    }
+
+    uint32 textureHash = 0;
+    for(const TPair<FName, UTexture*>& parameter : TextureParameters)
+    {
+        textureHash += HashCombine(GetTypeHash(parameter.Key), GetTypeHash(parameter.Value));
+    }
+
+    return HashCombine(HashCombine(scalarHash, vectorHash), textureHash);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+bool FRyMaterialParameterSet::operator==(const FRyMaterialParameterSet& other) const
+{
+    return ParameterMapsEqual(ScalarParameters, other.ScalarParameters, [](const float a, const float b) { return GetCanonicalBits(a) == GetCanonicalBits(b); })
+        && ParameterMapsEqual(VectorParameters, other.VectorParameters, [](const FLinearColor& a, const FLinearColor& b) { return CanonicalEqual(a, b); })
+        && TextureParameters.OrderIndependentCompareEqual(other.TextureParameters);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeMaterialCacheSubsystem::Deinitialize()
+{
+    SharedMaterials.Reset();
+    MaterialInfos.Reset();
+    MaterialsByHash.Reset();
+    SET_DWORD_STAT(STAT_RyMaterialCacheNumShared, 0);
+    Super::Deinitialize();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+UMaterialInstanceDynamic* URyRuntimeMaterialCacheSubsystem::AcquireSharedMaterial(UMaterialInterface* parentMaterial, const FRyMaterialParameterSet& parameters)
+{
+    if(!parentMaterial)
+    {
+        UE_LOG(LogRyRuntime, Warning, TEXT("AcquireSharedMaterial: Invalid parentMaterial"));
+        return nullptr;
+    }
+
+    const uint32 hash = GetKeyHash(parentMaterial, parameters);
+    for(auto it = MaterialsByHash.CreateKeyIterator(hash); it; ++it)
+    {
+        UMaterialInstanceDynamic* material = it.Value();
+        FSharedMaterialInfo& info = MaterialInfos.FindChecked(material);
+        if(material->Parent == parentMaterial && info.Parameters == parameters)
+        {
+            ++info.RefCount;
+            return material;
+        }
+    }
+
+    // Unseen combination. The cache is about to grow, first drop instances only held by dead or recycled components.
+    PruneDeadHolders();
+    UMaterialInstanceDynamic* material = UMaterialInstanceDynamic::Create(parentMaterial, this);
+    for(const TPair<FName, float>& parameter : parameters.ScalarParameters)
+    {
+        material->SetScalarParameterValue(parameter.Key, parameter.Value);
+    }
+    for(const TPair<FName, FLinearColor>& parameter : parameters.VectorParameters)
+    {
+        material->SetVectorParameterValue(parameter.Key, parameter.Value);
+    }
+    for(const TPair<FName, UTexture*>& parameter : parameters.TextureParameters)
+    {
+        material->SetTextureParameterValue(parameter.Key, parameter.Value);
+    }
+
+    SharedMaterials.Add(material);
+    MaterialInfos.Add(material, FSharedMaterialInfo{hash, 1, parameters, {}});
+    MaterialsByHash.Add(hash, material);
+    SET_DWORD_STAT(STAT_RyMaterialCacheNumShared, SharedMaterials.Num());
+    INC_DWORD_STAT(STAT_RyMaterialCacheCreated);
+    return material;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+bool URyRuntimeMaterialCacheSubsystem::ReleaseSharedMaterial(UMaterialInstanceDynamic* material)
+{
+    FSharedMaterialInfo* info = MaterialInfos.Find(material);
+    if(!info)
+    {
+        return false;
+    }
+
+    if(info->RefCount <= 0)
+    {
+        UE_LOG(LogRyRuntime, Warning, TEXT("ReleaseSharedMaterial: %s has no references from AcquireSharedMaterial left"), *material->GetName());
+        return false;
+    }
+
+    --info->RefCount;
+    info->Holders.RemoveAllSwap([material](const FHolder& holder) { return IsHolderDead(holder, material); }, false);
+    RemoveIfUnused(material, *info);
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+UMaterialInstanceDynamic* URyRuntimeMaterialCacheSubsystem::SetSharedMaterialOnComponent(UPrimitiveComponent* component, const int32 elementIndex,
+                                                                                        UMaterialInterface* parentMaterial,
+                                                                                        const FRyMaterialParameterSet& parameters)
+{
+    if(!component)
+    {
+        UE_LOG(LogRyRuntime, Warning, TEXT("SetSharedMaterialOnComponent: Invalid component"));
+        return nullptr;
+    }
+
+    // Acquire before releasing, so setting the same parameters again doesn't destroy and recreate the instance
+    UMaterialInstanceDynamic* material = AcquireSharedMaterial(parentMaterial, parameters);
+    if(!material)
+    {
+        return nullptr;
+    }
+
+    UMaterialInstanceDynamic* previousMaterial = Cast<UMaterialInstanceDynamic>(component->GetMaterial(elementIndex));
+    RemoveHolder(component, elementIndex, previousMaterial);
+    component->SetMaterial(elementIndex, material);
+
+    // The acquired reference becomes the slot's, dropped once the slot is cleared, changed or its component is gone
+    FSharedMaterialInfo& info = MaterialInfos.FindChecked(material);
+    --info.RefCount;
+    info.Holders.Add(FHolder{component, elementIndex});
+    return material;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeMaterialCacheSubsystem::ClearSharedMaterialOnComponent(UPrimitiveComponent* component, const int32 elementIndex)
+{
+    if(!component)
+    {
+        return;
+    }
+
+    UMaterialInstanceDynamic* material = Cast<UMaterialInstanceDynamic>(component->GetMaterial(elementIndex));
+    if(RemoveHolder(component, elementIndex, material))
+    {
+        // A null override falls back to the mesh's own material
+        component->SetMaterial(elementIndex, nullptr);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+int32 URyRuntimeMaterialCacheSubsystem::GetSharedMaterialRefCount(const UMaterialInstanceDynamic* material) const
+{
+    const FSharedMaterialInfo* info = MaterialInfos.Find(material);
+    if(!info)
+    {
+        return 0;
+    }
+
+    int32 numLiveHolders = 0;
+    for(const FHolder& holder : info->Holders)
+    {
+        numLiveHolders += IsHolderDead(holder, material) ? 0 : 1;
+    }
+    return info->RefCount + numLiveHolders;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+bool URyRuntimeMaterialCacheSubsystem::IsHolderDead(const FHolder& holder, const UMaterialInstanceDynamic* material)
+{
+    // Destroyed, or the slot has been given another material since (e.g. a pooled component being reused)
+    const UPrimitiveComponent* component = holder.Component.Get();
+    return !component || component->GetMaterial(holder.ElementIndex) != material;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+bool URyRuntimeMaterialCacheSubsystem::RemoveHolder(UPrimitiveComponent* component, const int32 elementIndex, UMaterialInstanceDynamic* material)
+{
+    FSharedMaterialInfo* info = MaterialInfos.Find(material);
+    if(!info)
+    {
+        return false;
+    }
+
+    const int32 numRemoved = info->Holders.RemoveAllSwap([component, elementIndex](const FHolder& holder)
+    {
+        return holder.Component.Get() == component && holder.ElementIndex == elementIndex;
+    }, false);
+    RemoveIfUnused(material, *info);
+    return numRemoved > 0;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeMaterialCacheSubsystem::PruneDeadHolders()
+{
+    TArray<UMaterialInstanceDynamic*, TInlineAllocator<16>> unusedMaterials;
+    for(TPair<const UMaterialInstanceDynamic*, FSharedMaterialInfo>& infoPair : MaterialInfos)
+    {
+        const UMaterialInstanceDynamic* material = infoPair.Key;
+        FSharedMaterialInfo& info = infoPair.Value;
+        info.Holders.RemoveAllSwap([material](const FHolder& holder) { return IsHolderDead(holder, material); }, false);
+        if(info.RefCount <= 0 && info.Holders.Num() == 0)
+        {
+            unusedMaterials.Add(const_cast<UMaterialInstanceDynamic*>(material));
+        }
+    }
+
+    for(UMaterialInstanceDynamic* material : unusedMaterials)
+    {
+        RemoveIfUnused(material, MaterialInfos.FindChecked(material));
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeMaterialCacheSubsystem::RemoveIfUnused(UMaterialInstanceDynamic* material, const FSharedMaterialInfo& info)
+{
+    if(info.RefCount > 0 || info.Holders.Num() > 0)
+    {
+        return;
+    }
+
+    MaterialsByHash.RemoveSingle(info.Hash, material);
+    SharedMaterials.RemoveSingleSwap(material, false);
+    MaterialInfos.Remove(material);
+    SET_DWORD_STAT(STAT_RyMaterialCacheNumShared, SharedMaterials.Num());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+uint32 URyRuntimeMaterialCacheSubsystem::GetKeyHash(const UMaterialInterface* parentMaterial, const FRyMaterialParameterSet& parameters)
+{
+    return HashCombine(GetTypeHash(parentMaterial), parameters.GetHash());
+}
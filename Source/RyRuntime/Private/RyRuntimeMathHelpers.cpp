@@ -9,9 +9,166 @@
 #include "Engine/GameViewportClient.h"
 #include "GameFramework/Character.h"
 #include "Kismet/KismetMathLibrary.h"
+#include "Engine/LocalPlayer.h"
+#include "SceneView.h"
+#include "Async/ParallelFor.h"
 
 static_assert(ERyUnit::Unspecified == static_cast<ERyUnit>(EUnit::Unspecified), "ERyUnit isn't aligned to EUnit!");
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+float URyRuntimeMathHelpers::SolveCatenaryScalingFactor(const float horizontalDistance, const float verticalDistance, const float length)
+{
+	const double h = FMath::Abs(horizontalDistance);
+	const double spanSquared = FMath::Square(length) - FMath::Square(static_cast<double>(verticalDistance));
+	if(h <= KINDA_SMALL_NUMBER || spanSquared <= FMath::Square(h) * (1.0 + KINDA_SMALL_NUMBER))
+	{
+		// Hanging straight down, or too short to sag
+		return 0.0f;
+	}
+
+	// Solve sinh(u) = r * u for u = h / (2 * scalingFactor).
+	// Both initial guesses land to the right of the root where f is convex and increasing, so Newton converges monotonically.
+	const double r = sqrt(spanSquared) / h;
+	double u = r < 3.0 ? sqrt(6.0 * (r - 1.0)) : log(2.0 * r) + log(log(2.0 * r)) + 1.0;
+	for(int32 iteration = 0; iteration < 32; ++iteration)
+	{
+		const double step = (sinh(u) - r * u) / (cosh(u) - r);
+		u -= step;
+		if(FMath::Abs(step) <= 1.e-9 * FMath::Max(1.0, u))
+		{
+			break;
+		}
+	}
+
+	return static_cast<float>(h / (2.0 * u));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeMathHelpers::CalculateCatenaryPolyline(const FVector& start, const FVector& end, const float length, TArray<FVector>& pointsOut,
+                                                      float& scalingFactor, const int32 numPoints)
+{
+	const int32 pointCount = FMath::Max(numPoints, 2);
+	pointsOut.SetNumUninitialized(pointCount);
+
+	const FVector delta = end - start;
+	const float horizontalDistance = delta.Size2D();
+	scalingFactor = SolveCatenaryScalingFactor(horizontalDistance, delta.Z, length);
+
+	const float pointStep = 1.0f / (pointCount - 1);
+	if(scalingFactor <= 0.0f)
+	{
+		for(int32 pointIndex = 0; pointIndex < pointCount; ++pointIndex)
+		{
+			pointsOut[pointIndex] = start + delta * (pointIndex * pointStep);
+		}
+	}
+	else
+	{
+		// y(x) = a * cosh((x - x0) / a) + c, passing through (0, 0) and (h, v)
+		const float a = scalingFactor;
+		const float slope = FMath::Clamp(delta.Z / length, -1.0f + KINDA_SMALL_NUMBER, 1.0f - KINDA_SMALL_NUMBER);
+		const float x0 = horizontalDistance * 0.5f - a * 0.5f * logf((1.0f + slope) / (1.0f - slope));
+		const float c = -a * coshf(-x0 / a);
+		const FVector horizontalDir = FVector(delta.X, delta.Y, 0.0f) / horizontalDistance;
+
+		for(int32 pointIndex = 0; pointIndex < pointCount; ++pointIndex)
+		{
+			const float x = horizontalDistance * (pointIndex * pointStep);
+			pointsOut[pointIndex] = start + horizontalDir * x + FVector(0.0f, 0.0f, a * coshf((x - x0) / a) + c);
+		}
+	}
+
+	// Always land exactly on the ends
+	pointsOut[0] = start;
+	pointsOut[pointCount - 1] = end;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+bool URyRuntimeMathHelpers::SolveCatenaryCable(FRyCatenaryCable& cable, const bool force)
+{
+	if(!force && cable.IsSolved())
+	{
+		return false;
+	}
+
+	cable.NumPoints = FMath::Max(cable.NumPoints, 2);
+	CalculateCatenaryPolyline(cable.Start, cable.End, cable.Length, cable.Points, cable.ScalingFactor, cable.NumPoints);
+	cable.SolvedStart = cable.Start;
+	cable.SolvedEnd = cable.End;
+	cable.SolvedLength = cable.Length;
+	return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+int32 URyRuntimeMathHelpers::SolveCatenaryCables(TArray<FRyCatenaryCable>& cables, const bool force)
+{
+	int32 numSolved = 0;
+	for(FRyCatenaryCable& cable : cables)
+	{
+		if(SolveCatenaryCable(cable, force))
+		{
+			++numSolved;
+		}
+	}
+	return numSolved;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+FRyUnitConversionPlan URyRuntimeMathHelpers::MakeUnitConversionPlan(const ERyUnit from, const ERyUnit to)
+{
+	FRyUnitConversionPlan plan;
+	plan.From = from;
+	plan.To = to;
+	plan.IsValid = FUnitConversion::AreUnitsCompatible(static_cast<EUnit>(from), static_cast<EUnit>(to));
+	if(plan.IsValid)
+	{
+		// Every unit conversion is affine, so converting 0 and 1 recovers the offset and scale.
+		// Resolved in double precision so the float plan is as close to ConvertUnit as possible.
+		const double offset = FUnitConversion::Convert<double>(0.0, static_cast<EUnit>(from), static_cast<EUnit>(to));
+		const double scale = FUnitConversion::Convert<double>(1.0, static_cast<EUnit>(from), static_cast<EUnit>(to)) - offset;
+		plan.Scale = static_cast<float>(scale);
+		plan.Offset = static_cast<float>(offset);
+	}
+	return plan;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeMathHelpers::ConvertUnitArray(const TArray<float>& values, const FRyUnitConversionPlan& plan, TArray<float>& valuesOut)
+{
+	const int32 num = values.Num();
+	if(&valuesOut != &values)
+	{
+		valuesOut.SetNumUninitialized(num);
+	}
+
+	const float* src = values.GetData();
+	float* dst = valuesOut.GetData();
+	const VectorRegister vecScale = VectorSetFloat1(plan.Scale);
+	const VectorRegister vecOffset = VectorSetFloat1(plan.Offset);
+
+	int32 index = 0;
+	for(; index + 4 <= num; index += 4)
+	{
+		VectorStore(VectorMultiplyAdd(VectorLoad(src + index), vecScale, vecOffset), dst + index);
+	}
+	for(; index < num; ++index)
+	{
+		dst[index] = plan.Convert(src[index]);
+	}
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 /**
 */
@@ -72,45 +229,278 @@ void URyRuntimeMathHelpers::RotationInterpolate(const float inCurrent, const flo
 
 //---------------------------------------------------------------------------------------------------------------------
 /**
+ * SIMD version of FRotator::ClampAxis, clamps 4 angles to [0, 360)
 */
-void URyRuntimeMathHelpers::FindScreenEdgeLocationForWorldLocation(UObject* WorldContextObject, const FVector& InLocation, 
-                                                                   const float EdgePercent, FVector2D& OutScreenPosition, 
-                                                                   float& OutRotationAngleDegrees, bool &bIsOnScreen)
+static FORCEINLINE VectorRegister VectorClampAxis(const VectorRegister& angles)
 {
-	bIsOnScreen = false;
-	OutRotationAngleDegrees = 0.f;
+	const VectorRegister vec360 = VectorSetFloat1(360.0f);
+	VectorRegister result = VectorSubtract(angles, VectorMultiply(VectorTruncate(VectorDivide(angles, vec360)), vec360));
+
+	// Negative remainders wrap around, and rounding can land exactly on 360
+	result = VectorAdd(result, VectorBitwiseAnd(VectorCompareGT(VectorZero(), result), vec360));
+	result = VectorSubtract(result, VectorBitwiseAnd(VectorCompareGE(result, vec360), vec360));
+	return result;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * SIMD version of ShortestRotationPath for angles already clamped to [0, 360)
+ * Branchless form: d = (B - A) wrapped to [0, 360), then the path is d if under half a turn, else d - 360.
+*/
+static FORCEINLINE VectorRegister VectorShortestRotationPathClamped(const VectorRegister& clampA, const VectorRegister& clampB)
+{
+	const VectorRegister vec360 = VectorSetFloat1(360.0f);
+	const VectorRegister vec180 = VectorSetFloat1(180.0f);
+	const VectorRegister forward = VectorAdd(VectorSubtract(clampB, clampA), VectorBitwiseAnd(VectorCompareGT(clampA, clampB), vec360));
+	return VectorSubtract(forward, VectorBitwiseAnd(VectorCompareGE(forward, vec180), vec360));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeMathHelpers::ShortestRotationPathArray(const TArray<float>& startRotations, const TArray<float>& endRotations, TArray<float>& pathsOut)
+{
+	if(startRotations.Num() != endRotations.Num())
+	{
+		UE_LOG(LogRyRuntime, Warning, TEXT("ShortestRotationPathArray called with misaligned arrays! startRotations and endRotations must be the same length."));
+		pathsOut.Reset();
+		return;
+	}
+
+	pathsOut.SetNumUninitialized(startRotations.Num());
+	ShortestRotationPathBatch(startRotations.GetData(), endRotations.GetData(), pathsOut.GetData(), startRotations.Num());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeMathHelpers::RotationInterpolateArray(const TArray<float>& currents, const TArray<float>& targets, const float deltaTime, const TArray<float>& speeds,
+                                                     TArray<float>& newRotations, TArray<bool>& atTargets, const float checkTolerance)
+{
+	if(currents.Num() != targets.Num() || currents.Num() != speeds.Num())
+	{
+		UE_LOG(LogRyRuntime, Warning, TEXT("RotationInterpolateArray called with misaligned arrays! currents, targets and speeds must be the same length."));
+		newRotations.Reset();
+		atTargets.Reset();
+		return;
+	}
+
+	newRotations.SetNumUninitialized(currents.Num());
+	atTargets.SetNumUninitialized(currents.Num());
+	RotationInterpolateBatch(currents.GetData(), targets.GetData(), speeds.GetData(), deltaTime, checkTolerance,
+	                         newRotations.GetData(), atTargets.GetData(), currents.Num());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeMathHelpers::ShortestRotationPathBatch(const float* startRotations, const float* endRotations, float* pathsOut, const int32 num)
+{
+	int32 index = 0;
+	for(; index + 4 <= num; index += 4)
+	{
+		const VectorRegister clampA = VectorClampAxis(VectorLoad(startRotations + index));
+		const VectorRegister clampB = VectorClampAxis(VectorLoad(endRotations + index));
+		VectorStore(VectorShortestRotationPathClamped(clampA, clampB), pathsOut + index);
+	}
+
+	for(; index < num; ++index)
+	{
+		pathsOut[index] = ShortestRotationPath(startRotations[index], endRotations[index]);
+	}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeMathHelpers::RotationInterpolateBatch(const float* currents, const float* targets, const float* speeds, const float deltaTime,
+                                                     const float checkTolerance, float* newRotations, bool* atTargets, const int32 num)
+{
+	const VectorRegister vecDeltaTime = VectorSetFloat1(deltaTime);
+	const VectorRegister vecTolerance = VectorSetFloat1(checkTolerance);
+
+	int32 index = 0;
+	for(; index + 4 <= num; index += 4)
+	{
+		const VectorRegister clampCurrent = VectorClampAxis(VectorLoad(currents + index));
+		const VectorRegister clampTarget = VectorClampAxis(VectorLoad(targets + index));
+		const VectorRegister pathTo = VectorShortestRotationPathClamped(clampCurrent, clampTarget);
+		const VectorRegister absPathTo = VectorAbs(pathTo);
+
+		// Move towards the target along the shortest path
+		const VectorRegister step = VectorMultiply(VectorLoad(speeds + index), vecDeltaTime);
+		const VectorRegister movement = VectorSelect(VectorCompareGT(VectorZero(), pathTo), VectorNegate(step), step);
+		const VectorRegister moved = VectorClampAxis(VectorAdd(clampCurrent, movement));
+
+		// At target if already there, if the movement would overshoot, or if we landed within tolerance
+		const VectorRegister alreadyThere = VectorCompareGE(vecTolerance, absPathTo);
+		const VectorRegister overshoot = VectorCompareGE(VectorAbs(step), absPathTo);
+		const VectorRegister landed = VectorCompareGE(vecTolerance, VectorAbs(VectorShortestRotationPathClamped(clampTarget, moved)));
+		const VectorRegister atTargetMask = VectorBitwiseOr(VectorBitwiseOr(alreadyThere, overshoot), landed);
+
+		VectorStore(VectorSelect(atTargetMask, clampTarget, moved), newRotations + index);
 
-	if (!GEngine)
+		const int32 atTargetBits = VectorMaskBits(atTargetMask);
+		atTargets[index + 0] = (atTargetBits & 1) != 0;
+		atTargets[index + 1] = (atTargetBits & 2) != 0;
+		atTargets[index + 2] = (atTargetBits & 4) != 0;
+		atTargets[index + 3] = (atTargetBits & 8) != 0;
+	}
+
+	for(; index < num; ++index)
+	{
+		RotationInterpolate(currents[index], targets[index], deltaTime, speeds[index], newRotations[index], atTargets[index], checkTolerance);
+	}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeMathHelpers::BenchmarkRotationInterpolate(const int32 numElements, const int32 iterations, float& scalarMilliseconds, float& batchMilliseconds, float& maxError)
+{
+	scalarMilliseconds = batchMilliseconds = maxError = 0.0f;
+	if(numElements <= 0 || iterations <= 0)
 	{
 		return;
 	}
 
-	const FVector2D ViewportSize = FVector2D(GEngine->GameViewport->Viewport->GetSizeXY());
-	const FVector2D  ViewportCenter = FVector2D(ViewportSize.X / 2, ViewportSize.Y / 2);
+	FRandomStream randomStream(numElements);
+	TArray<float> currents, targets, speeds;
+	currents.SetNumUninitialized(numElements);
+	targets.SetNumUninitialized(numElements);
+	speeds.SetNumUninitialized(numElements);
+	for(int32 index = 0; index < numElements; ++index)
+	{
+		currents[index] = randomStream.FRandRange(-720.0f, 720.0f);
+		targets[index] = randomStream.FRandRange(-720.0f, 720.0f);
+		speeds[index] = randomStream.FRandRange(0.0f, 180.0f);
+	}
+
+	const float deltaTime = 1.0f / 60.0f;
+	TArray<float> scalarRotations, batchRotations;
+	TArray<bool> scalarAtTargets, batchAtTargets;
+	scalarRotations.SetNumUninitialized(numElements);
+	scalarAtTargets.SetNumUninitialized(numElements);
+
+	double startTime = FPlatformTime::Seconds();
+	for(int32 iteration = 0; iteration < iterations; ++iteration)
+	{
+		for(int32 index = 0; index < numElements; ++index)
+		{
+			RotationInterpolate(currents[index], targets[index], deltaTime, speeds[index], scalarRotations[index], scalarAtTargets[index]);
+		}
+	}
+	scalarMilliseconds = static_cast<float>((FPlatformTime::Seconds() - startTime) * 1000.0 / iterations);
+
+	startTime = FPlatformTime::Seconds();
+	for(int32 iteration = 0; iteration < iterations; ++iteration)
+	{
+		RotationInterpolateArray(currents, targets, deltaTime, speeds, batchRotations, batchAtTargets);
+	}
+	batchMilliseconds = static_cast<float>((FPlatformTime::Seconds() - startTime) * 1000.0 / iterations);
+
+	for(int32 index = 0; index < numElements; ++index)
+	{
+		maxError = FMath::Max(maxError, FMath::Abs(ShortestRotationPath(scalarRotations[index], batchRotations[index])));
+	}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * Everything FindScreenEdgeLocationForWorldLocation needs which doesn't depend on the location being projected.
+ * Resolved once per call so batches only pay for it once.
+*/
+struct FRyScreenEdgeContext
+{
+	FVector2D ViewportSize;
+	FVector2D ViewportCenter;
+	FVector PawnLocation;
+	FVector PawnForward;
+
+	// Equivalent of APlayerController::ProjectWorldLocationToScreen with the projection resolved up front
+	bool HasProjection;
+	FIntRect ViewRect;
+	FMatrix ViewProjectionMatrix;
+
+	void ProjectWorldLocationToScreen(const FVector& worldLocation, FVector2D& screenPosition) const
+	{
+		if(!HasProjection)
+		{
+			screenPosition = FVector2D::ZeroVector;
+			return;
+		}
+
+		// Like the player controller version, screenPosition is left untouched if the location is behind the view
+		FSceneView::ProjectWorldToScreen(worldLocation, ViewRect, ViewProjectionMatrix, screenPosition);
+	}
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+static bool ResolveScreenEdgeContext(UObject* WorldContextObject, FRyScreenEdgeContext& context)
+{
+	if (!GEngine || !GEngine->GameViewport || !GEngine->GameViewport->Viewport)
+	{
+		return false;
+	}
+
+	context.ViewportSize = FVector2D(GEngine->GameViewport->Viewport->GetSizeXY());
+	context.ViewportCenter = FVector2D(context.ViewportSize.X / 2, context.ViewportSize.Y / 2);
 
 	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
 
 	if (!World)
 	{
-		return;
+		return false;
 	}
 
 	APlayerController* PlayerController = (WorldContextObject ? UGameplayStatics::GetPlayerController(WorldContextObject, 0) : nullptr);
 	if (!PlayerController)
 	{
-		return;
+		return false;
 	}
 
 	ACharacter* PlayerCharacter = Cast<ACharacter>(PlayerController->GetPawn());
 	if (!PlayerCharacter)
 	{
-		return;
+		return false;
+	}
+
+	context.PawnLocation = PlayerCharacter->GetActorLocation();
+	context.PawnForward = PlayerCharacter->GetActorForwardVector();
+
+	context.HasProjection = false;
+	ULocalPlayer* const LocalPlayer = PlayerController->GetLocalPlayer();
+	if (LocalPlayer && LocalPlayer->ViewportClient)
+	{
+		FSceneViewProjectionData ProjectionData;
+		if (LocalPlayer->GetProjectionData(LocalPlayer->ViewportClient->Viewport, eSSP_FULL, ProjectionData))
+		{
+			context.HasProjection = true;
+			context.ViewRect = ProjectionData.GetConstrainedViewRect();
+			context.ViewProjectionMatrix = ProjectionData.ComputeViewProjectionMatrix();
+		}
 	}
 
-	const FVector Forward = PlayerCharacter->GetActorForwardVector();
-	const FVector Offset = (InLocation - PlayerCharacter->GetActorLocation()).GetSafeNormal();
+	return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+static void FindScreenEdgeLocation(const FRyScreenEdgeContext& context, const FVector& InLocation, const float EdgePercent,
+                                   FVector2D& OutScreenPosition, float& OutRotationAngleDegrees, bool &bIsOnScreen)
+{
+	bIsOnScreen = false;
+	OutRotationAngleDegrees = 0.f;
+
+	const FVector2D& ViewportSize = context.ViewportSize;
+	const FVector2D& ViewportCenter = context.ViewportCenter;
+
+	const FVector Offset = (InLocation - context.PawnLocation).GetSafeNormal();
 
-	const float DotProduct = FVector::DotProduct(Forward, Offset);
+	const float DotProduct = FVector::DotProduct(context.PawnForward, Offset);
 	const bool bLocationIsBehindCamera = (DotProduct < 0);
 	if (bLocationIsBehindCamera)
 	{
@@ -119,18 +509,18 @@ void URyRuntimeMathHelpers::FindScreenEdgeLocationForWorldLocation(UObject* Worl
 		// as you turn around. Could stand some refinement, but results
 		// are decent enough for most purposes.
 
-		const FVector DiffVector = InLocation - PlayerCharacter->GetActorLocation();
+		const FVector DiffVector = InLocation - context.PawnLocation;
 		const FVector Inverted = DiffVector * -1.f;
-		FVector NewInLocation = PlayerCharacter->GetActorLocation() * Inverted;
+		FVector NewInLocation = context.PawnLocation * Inverted;
 
 		NewInLocation.Z -= 5000;
 
-		PlayerController->ProjectWorldLocationToScreen(NewInLocation, OutScreenPosition);
+		context.ProjectWorldLocationToScreen(NewInLocation, OutScreenPosition);
 		OutScreenPosition.Y = (EdgePercent * ViewportCenter.X) * 2.f;
 		OutScreenPosition.X = -ViewportCenter.X - OutScreenPosition.X;
 	}
 
-	PlayerController->ProjectWorldLocationToScreen(InLocation, OutScreenPosition); // * ScreenPosition);
+	context.ProjectWorldLocationToScreen(InLocation, OutScreenPosition); // * ScreenPosition);
 
 	// Check to see if it's on screen. If it is, ProjectWorldLocationToScreen is all we need, return it.	
 	if (OutScreenPosition.X >= 0.f && OutScreenPosition.X <= ViewportSize.X
@@ -178,6 +568,49 @@ void URyRuntimeMathHelpers::FindScreenEdgeLocationForWorldLocation(UObject* Worl
 	OutScreenPosition += ViewportCenter;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeMathHelpers::FindScreenEdgeLocationForWorldLocation(UObject* WorldContextObject, const FVector& InLocation, 
+                                                                   const float EdgePercent, FVector2D& OutScreenPosition, 
+                                                                   float& OutRotationAngleDegrees, bool &bIsOnScreen)
+{
+	FRyScreenEdgeContext context;
+	if (!ResolveScreenEdgeContext(WorldContextObject, context))
+	{
+		bIsOnScreen = false;
+		OutRotationAngleDegrees = 0.f;
+		return;
+	}
+
+	FindScreenEdgeLocation(context, InLocation, EdgePercent, OutScreenPosition, OutRotationAngleDegrees, bIsOnScreen);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeMathHelpers::FindScreenEdgeLocationsForWorldLocations(UObject* WorldContextObject, const TArray<FVector>& InLocations,
+                                                                     const float EdgePercent, TArray<FVector2D>& OutScreenPositions,
+                                                                     TArray<float>& OutRotationAnglesDegrees, TArray<bool>& OutIsOnScreen)
+{
+	const int32 numLocations = InLocations.Num();
+	OutScreenPositions.SetNumZeroed(numLocations);
+	OutRotationAnglesDegrees.SetNumZeroed(numLocations);
+	OutIsOnScreen.SetNumZeroed(numLocations);
+
+	FRyScreenEdgeContext context;
+	if (!ResolveScreenEdgeContext(WorldContextObject, context))
+	{
+		return;
+	}
+
+	for (int32 locationIndex = 0; locationIndex < numLocations; ++locationIndex)
+	{
+		FindScreenEdgeLocation(context, InLocations[locationIndex], EdgePercent, OutScreenPositions[locationIndex],
+		                       OutRotationAnglesDegrees[locationIndex], OutIsOnScreen[locationIndex]);
+	}
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 /**
 */
@@ -230,3 +663,1555 @@ FVector2D URyRuntimeMathHelpers::FindEdgeOf2DSquare(const FVector2D &TheSize, co
     // Return
     return (TheSize / 2.0f) + LocalPointRelativeToCenter;
 }
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * Gathers the X and Y components of 4 consecutive vectors into structure of arrays registers
+*/
+static FORCEINLINE void VectorLoadXY4(const FVector* vectors, VectorRegister& outX, VectorRegister& outY)
+{
+	outX = MakeVectorRegister(vectors[0].X, vectors[1].X, vectors[2].X, vectors[3].X);
+	outY = MakeVectorRegister(vectors[0].Y, vectors[1].Y, vectors[2].Y, vectors[3].Y);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeMathHelpers::Dot_VectorArray2D(const TArray<FVector>& Vectors, const FVector& Reference, TArray<float>& DotProductsOut)
+{
+	const int32 num = Vectors.Num();
+	DotProductsOut.SetNumUninitialized(num);
+
+	const FVector* src = Vectors.GetData();
+	float* dst = DotProductsOut.GetData();
+	const VectorRegister refX = VectorSetFloat1(Reference.X);
+	const VectorRegister refY = VectorSetFloat1(Reference.Y);
+
+	int32 index = 0;
+	for(; index + 4 <= num; index += 4)
+	{
+		VectorRegister x, y;
+		VectorLoadXY4(src + index, x, y);
+		VectorStore(VectorMultiplyAdd(x, refX, VectorMultiply(y, refY)), dst + index);
+	}
+	for(; index < num; ++index)
+	{
+		dst[index] = src[index].X * Reference.X + src[index].Y * Reference.Y;
+	}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeMathHelpers::DistanceSquared_VectorArray2D(const TArray<FVector>& Points, const FVector& Reference, TArray<float>& DistancesSquaredOut)
+{
+	const int32 num = Points.Num();
+	DistancesSquaredOut.SetNumUninitialized(num);
+
+	const FVector* src = Points.GetData();
+	float* dst = DistancesSquaredOut.GetData();
+	const VectorRegister refX = VectorSetFloat1(Reference.X);
+	const VectorRegister refY = VectorSetFloat1(Reference.Y);
+
+	int32 index = 0;
+	for(; index + 4 <= num; index += 4)
+	{
+		VectorRegister x, y;
+		VectorLoadXY4(src + index, x, y);
+		x = VectorSubtract(x, refX);
+		y = VectorSubtract(y, refY);
+		VectorStore(VectorMultiplyAdd(x, x, VectorMultiply(y, y)), dst + index);
+	}
+	for(; index < num; ++index)
+	{
+		dst[index] = FVector::DistSquared2D(src[index], Reference);
+	}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+int32 URyRuntimeMathHelpers::FindNearestPoint2D(const TArray<FVector>& Points, const FVector& Reference, float& DistanceSquaredOut)
+{
+	const int32 num = Points.Num();
+	DistanceSquaredOut = 0.0f;
+	if(num == 0)
+	{
+		return INDEX_NONE;
+	}
+
+	const FVector* src = Points.GetData();
+	int32 bestIndex = INDEX_NONE;
+	float bestDistanceSquared = MAX_FLT;
+
+	int32 index = 0;
+	if(num >= 4)
+	{
+		// Track the best distance and index per lane. Indices are kept as floats so they can share VectorSelect.
+		const VectorRegister refX = VectorSetFloat1(Reference.X);
+		const VectorRegister refY = VectorSetFloat1(Reference.Y);
+		const VectorRegister indexStep = VectorSetFloat1(4.0f);
+		VectorRegister laneIndices = MakeVectorRegister(0.0f, 1.0f, 2.0f, 3.0f);
+		VectorRegister laneBestDistances = VectorSetFloat1(MAX_FLT);
+		VectorRegister laneBestIndices = VectorSetFloat1(-1.0f);
+
+		for(; index + 4 <= num; index += 4)
+		{
+			VectorRegister x, y;
+			VectorLoadXY4(src + index, x, y);
+			x = VectorSubtract(x, refX);
+			y = VectorSubtract(y, refY);
+			const VectorRegister distances = VectorMultiplyAdd(x, x, VectorMultiply(y, y));
+
+			// Strictly closer only, so earlier indices win ties within a lane
+			const VectorRegister closer = VectorCompareGT(laneBestDistances, distances);
+			laneBestDistances = VectorSelect(closer, distances, laneBestDistances);
+			laneBestIndices = VectorSelect(closer, laneIndices, laneBestIndices);
+			laneIndices = VectorAdd(laneIndices, indexStep);
+		}
+
+		float distances[4], indices[4];
+		VectorStore(laneBestDistances, distances);
+		VectorStore(laneBestIndices, indices);
+		for(int32 lane = 0; lane < 4; ++lane)
+		{
+			const int32 laneIndex = static_cast<int32>(indices[lane]);
+			if(laneIndex != INDEX_NONE && (distances[lane] < bestDistanceSquared || (distances[lane] == bestDistanceSquared && laneIndex < bestIndex)))
+			{
+				bestDistanceSquared = distances[lane];
+				bestIndex = laneIndex;
+			}
+		}
+	}
+
+	for(; index < num; ++index)
+	{
+		const float distanceSquared = FVector::DistSquared2D(src[index], Reference);
+		if(distanceSquared < bestDistanceSquared || bestIndex == INDEX_NONE)
+		{
+			bestDistanceSquared = distanceSquared;
+			bestIndex = index;
+		}
+	}
+
+	DistanceSquaredOut = bestDistanceSquared;
+	return bestIndex;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeMathHelpers::GetForwardVectors2D(const TArray<FRotator>& InRots, TArray<FVector>& ForwardVectorsOut)
+{
+	const int32 num = InRots.Num();
+	ForwardVectorsOut.SetNumUninitialized(num);
+
+	const FRotator* src = InRots.GetData();
+	FVector* dst = ForwardVectorsOut.GetData();
+
+	// The 2D forward vector of a rotation is (cos(yaw), sin(yaw)) flipped by the sign of cos(pitch),
+	// or zero when pitched straight up or down (matching FVector::GetSafeNormal2D)
+	const VectorRegister degreesToRadians = VectorSetFloat1(PI / 180.0f);
+	const VectorRegister verticalTolerance = VectorSetFloat1(1.e-4f);
+	const VectorRegister one = VectorOne();
+
+	int32 index = 0;
+	for(; index + 4 <= num; index += 4)
+	{
+		const VectorRegister pitches = VectorMultiply(MakeVectorRegister(src[index].Pitch, src[index + 1].Pitch, src[index + 2].Pitch, src[index + 3].Pitch), degreesToRadians);
+		const VectorRegister yaws = VectorMultiply(MakeVectorRegister(src[index].Yaw, src[index + 1].Yaw, src[index + 2].Yaw, src[index + 3].Yaw), degreesToRadians);
+
+		VectorRegister sinPitch, cosPitch, sinYaw, cosYaw;
+		VectorSinCos(&sinPitch, &cosPitch, &pitches);
+		VectorSinCos(&sinYaw, &cosYaw, &yaws);
+
+		const VectorRegister pitchSign = VectorSelect(VectorCompareGT(VectorZero(), cosPitch), VectorNegate(one), one);
+		const VectorRegister notVertical = VectorCompareGE(VectorAbs(cosPitch), verticalTolerance);
+
+		float x[4], y[4];
+		VectorStore(VectorBitwiseAnd(VectorMultiply(cosYaw, pitchSign), notVertical), x);
+		VectorStore(VectorBitwiseAnd(VectorMultiply(sinYaw, pitchSign), notVertical), y);
+		for(int32 lane = 0; lane < 4; ++lane)
+		{
+			dst[index + lane] = FVector(x[lane], y[lane], 0.0f);
+		}
+	}
+	for(; index < num; ++index)
+	{
+		dst[index] = GetForwardVector2D(src[index]);
+	}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * SIMD version of FastExp
+*/
+static FORCEINLINE VectorRegister VectorFastExp(const VectorRegister& A)
+{
+	const VectorRegister one = VectorOne();
+	const VectorRegister clamped = VectorMin(VectorMax(A, VectorSetFloat1(RyFastMath::ExpMin)), VectorSetFloat1(RyFastMath::ExpMax));
+	const VectorRegister log2e = VectorSetFloat1(RyFastMath::Log2E);
+	const VectorRegister t = VectorMultiply(clamped, log2e);
+
+	// Floor from truncate, stepping down where truncation rounded a negative value up
+	VectorRegister n = VectorTruncate(t);
+	n = VectorSelect(VectorCompareGT(n, t), VectorSubtract(n, one), n);
+	VectorRegister r = VectorSubtract(clamped, VectorMultiply(n, VectorSetFloat1(RyFastMath::Ln2Hi)));
+	r = VectorSubtract(r, VectorMultiply(n, VectorSetFloat1(RyFastMath::Ln2Lo)));
+	const VectorRegister f = VectorMultiply(r, log2e);
+
+	VectorRegister p = VectorMultiplyAdd(f, VectorSetFloat1(RyFastMath::Exp2C5), VectorSetFloat1(RyFastMath::Exp2C4));
+	p = VectorMultiplyAdd(f, p, VectorSetFloat1(RyFastMath::Exp2C3));
+	p = VectorMultiplyAdd(f, p, VectorSetFloat1(RyFastMath::Exp2C2));
+	p = VectorMultiplyAdd(f, p, VectorSetFloat1(RyFastMath::Exp2C1));
+	p = VectorMultiplyAdd(f, p, VectorSetFloat1(RyFastMath::Exp2C0));
+
+	const VectorRegisterInt scaleBits = VectorShiftLeftImm(VectorIntAdd(VectorFloatToInt(n), VectorIntSet1(127)), 23);
+	return VectorMultiply(p, VectorCastIntToFloat(scaleBits));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * SIMD version of FastSinH
+*/
+static FORCEINLINE VectorRegister VectorFastSinH(const VectorRegister& A)
+{
+	const VectorRegister e = VectorFastExp(A);
+	const VectorRegister exponential = VectorMultiply(VectorSetFloat1(0.5f), VectorSubtract(e, VectorDivide(VectorOne(), e)));
+
+	const VectorRegister a2 = VectorMultiply(A, A);
+	VectorRegister series = VectorMultiplyAdd(a2, VectorSetFloat1(1.0f / 5040.0f), VectorSetFloat1(1.0f / 120.0f));
+	series = VectorMultiplyAdd(a2, series, VectorSetFloat1(1.0f / 6.0f));
+	series = VectorMultiplyAdd(a2, series, VectorOne());
+	series = VectorMultiply(A, series);
+
+	return VectorSelect(VectorCompareGT(VectorSetFloat1(RyFastMath::SinHSeriesLimit), VectorAbs(A)), series, exponential);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * SIMD version of FastCosH
+*/
+static FORCEINLINE VectorRegister VectorFastCosH(const VectorRegister& A)
+{
+	const VectorRegister e = VectorFastExp(A);
+	return VectorMultiply(VectorSetFloat1(0.5f), VectorAdd(e, VectorDivide(VectorOne(), e)));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * SIMD version of FastSinCos
+*/
+static FORCEINLINE void VectorFastSinCos(const VectorRegister& A, VectorRegister& sinOut, VectorRegister& cosOut)
+{
+	const VectorRegister half = VectorSetFloat1(0.5f);
+	const VectorRegister halfPi = VectorSetFloat1(HALF_PI);
+	const VectorRegister pi = VectorSetFloat1(PI);
+
+	// Reduce to [-PI, PI]
+	VectorRegister quotient = VectorMultiply(A, VectorSetFloat1(0.5f / PI));
+	quotient = VectorTruncate(VectorAdd(quotient, VectorSelect(VectorCompareGE(quotient, VectorZero()), half, VectorNegate(half))));
+	VectorRegister y = VectorSubtract(A, VectorMultiply(quotient, VectorSetFloat1(RyFastMath::TwoPiHi)));
+	y = VectorSubtract(y, VectorMultiply(quotient, VectorSetFloat1(RyFastMath::TwoPiLo)));
+
+	// Reflect to [-PI/2, PI/2], where cos changes sign
+	const VectorRegister above = VectorCompareGT(y, halfPi);
+	const VectorRegister below = VectorCompareGT(VectorNegate(halfPi), y);
+	const VectorRegister sign = VectorSelect(VectorBitwiseOr(above, below), VectorNegate(VectorOne()), VectorOne());
+	y = VectorSelect(above, VectorSubtract(pi, y), y);
+	y = VectorSelect(below, VectorSubtract(VectorNegate(pi), y), y);
+
+	const VectorRegister y2 = VectorMultiply(y, y);
+	VectorRegister s = VectorMultiplyAdd(y2, VectorSetFloat1(RyFastMath::SinC7), VectorSetFloat1(RyFastMath::SinC5));
+	s = VectorMultiplyAdd(y2, s, VectorSetFloat1(RyFastMath::SinC3));
+	s = VectorMultiplyAdd(y2, s, VectorSetFloat1(RyFastMath::SinC1));
+	sinOut = VectorMultiply(y, s);
+
+	VectorRegister c = VectorMultiplyAdd(y2, VectorSetFloat1(RyFastMath::CosC6), VectorSetFloat1(RyFastMath::CosC4));
+	c = VectorMultiplyAdd(y2, c, VectorSetFloat1(RyFastMath::CosC2));
+	c = VectorMultiplyAdd(y2, c, VectorSetFloat1(RyFastMath::CosC0));
+	cosOut = VectorMultiply(sign, c);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * SIMD version of FastAtan2
+*/
+static FORCEINLINE VectorRegister VectorFastAtan2(const VectorRegister& Y, const VectorRegister& X)
+{
+	const VectorRegister absX = VectorAbs(X);
+	const VectorRegister absY = VectorAbs(Y);
+	const VectorRegister maxXY = VectorMax(absX, absY);
+
+	// When both are zero min is zero too, so dividing by 1 gives the zero we want
+	const VectorRegister z = VectorDivide(VectorMin(absX, absY), VectorSelect(VectorCompareGT(maxXY, VectorZero()), maxXY, VectorOne()));
+	const VectorRegister z2 = VectorMultiply(z, z);
+	VectorRegister result = VectorMultiplyAdd(z2, VectorSetFloat1(RyFastMath::AtanC11), VectorSetFloat1(RyFastMath::AtanC9));
+	result = VectorMultiplyAdd(z2, result, VectorSetFloat1(RyFastMath::AtanC7));
+	result = VectorMultiplyAdd(z2, result, VectorSetFloat1(RyFastMath::AtanC5));
+	result = VectorMultiplyAdd(z2, result, VectorSetFloat1(RyFastMath::AtanC3));
+	result = VectorMultiplyAdd(z2, result, VectorSetFloat1(RyFastMath::AtanC1));
+	result = VectorMultiply(z, result);
+
+	result = VectorSelect(VectorCompareGT(absY, absX), VectorSubtract(VectorSetFloat1(HALF_PI), result), result);
+	result = VectorSelect(VectorCompareGT(VectorZero(), X), VectorSubtract(VectorSetFloat1(PI), result), result);
+	return VectorSelect(VectorCompareGT(VectorZero(), Y), VectorNegate(result), result);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeMathHelpers::FastSinHBatch(const float* values, float* valuesOut, const int32 num)
+{
+	int32 index = 0;
+	for(; index + 4 <= num; index += 4)
+	{
+		VectorStore(VectorFastSinH(VectorLoad(values + index)), valuesOut + index);
+	}
+	for(; index < num; ++index)
+	{
+		valuesOut[index] = FastSinH(values[index]);
+	}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeMathHelpers::FastCosHBatch(const float* values, float* valuesOut, const int32 num)
+{
+	int32 index = 0;
+	for(; index + 4 <= num; index += 4)
+	{
+		VectorStore(VectorFastCosH(VectorLoad(values + index)), valuesOut + index);
+	}
+	for(; index < num; ++index)
+	{
+		valuesOut[index] = FastCosH(values[index]);
+	}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeMathHelpers::FastSinCosBatch(const float* angles, float* sinsOut, float* cossOut, const int32 num)
+{
+	int32 index = 0;
+	for(; index + 4 <= num; index += 4)
+	{
+		VectorRegister s, c;
+		VectorFastSinCos(VectorLoad(angles + index), s, c);
+		VectorStore(s, sinsOut + index);
+		VectorStore(c, cossOut + index);
+	}
+	for(; index < num; ++index)
+	{
+		FastSinCos(angles[index], sinsOut[index], cossOut[index]);
+	}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeMathHelpers::FastAtan2Batch(const float* ys, const float* xs, float* anglesOut, const int32 num)
+{
+	int32 index = 0;
+	for(; index + 4 <= num; index += 4)
+	{
+		VectorStore(VectorFastAtan2(VectorLoad(ys + index), VectorLoad(xs + index)), anglesOut + index);
+	}
+	for(; index < num; ++index)
+	{
+		anglesOut[index] = FastAtan2(ys[index], xs[index]);
+	}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeMathHelpers::FastCalculateCatenaryBatch(const float* xs, const float scalingFactor, float* valuesOut, const int32 num)
+{
+	const VectorRegister scale = VectorSetFloat1(scalingFactor);
+	int32 index = 0;
+	for(; index + 4 <= num; index += 4)
+	{
+		VectorStore(VectorMultiply(scale, VectorFastCosH(VectorDivide(VectorLoad(xs + index), scale))), valuesOut + index);
+	}
+	for(; index < num; ++index)
+	{
+		valuesOut[index] = FastCalculateCatenary(xs[index], scalingFactor);
+	}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeMathHelpers::FastSinHArray(const TArray<float>& values, TArray<float>& valuesOut)
+{
+	valuesOut.SetNumUninitialized(values.Num());
+	FastSinHBatch(values.GetData(), valuesOut.GetData(), values.Num());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeMathHelpers::FastCosHArray(const TArray<float>& values, TArray<float>& valuesOut)
+{
+	valuesOut.SetNumUninitialized(values.Num());
+	FastCosHBatch(values.GetData(), valuesOut.GetData(), values.Num());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeMathHelpers::FastSinCosArray(const TArray<float>& angles, TArray<float>& sinsOut, TArray<float>& cossOut)
+{
+	sinsOut.SetNumUninitialized(angles.Num());
+	cossOut.SetNumUninitialized(angles.Num());
+	FastSinCosBatch(angles.GetData(), sinsOut.GetData(), cossOut.GetData(), angles.Num());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeMathHelpers::FastAtan2Array(const TArray<float>& ys, const TArray<float>& xs, TArray<float>& anglesOut)
+{
+	if(ys.Num() != xs.Num())
+	{
+		UE_LOG(LogRyRuntime, Warning, TEXT("FastAtan2Array: ys and xs must be the same length"));
+		anglesOut.Reset();
+		return;
+	}
+
+	anglesOut.SetNumUninitialized(ys.Num());
+	FastAtan2Batch(ys.GetData(), xs.GetData(), anglesOut.GetData(), ys.Num());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeMathHelpers::FastCalculateCatenaryArray(const TArray<float>& xs, const float scalingFactor, TArray<float>& valuesOut)
+{
+	valuesOut.SetNumUninitialized(xs.Num());
+	FastCalculateCatenaryBatch(xs.GetData(), scalingFactor, valuesOut.GetData(), xs.Num());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeMathHelpers::BenchmarkFastMath(const int32 numElements, const int32 iterations, TArray<FRyFastMathBenchmarkResult>& results)
+{
+	results.Reset();
+	if(numElements <= 0 || iterations <= 0)
+	{
+		return;
+	}
+
+	FRandomStream randomStream(numElements);
+	TArray<float> hyperbolicInputs, catenaryInputs, angleInputs, ys, xs;
+	hyperbolicInputs.SetNumUninitialized(numElements);
+	catenaryInputs.SetNumUninitialized(numElements);
+	angleInputs.SetNumUninitialized(numElements);
+	ys.SetNumUninitialized(numElements);
+	xs.SetNumUninitialized(numElements);
+	const float catenaryScalingFactor = 3.0f;
+	for(int32 index = 0; index < numElements; ++index)
+	{
+		// The whole documented domain, where the exp range reduction is hardest
+		hyperbolicInputs[index] = randomStream.FRandRange(RyFastMath::ExpMin, RyFastMath::ExpMax);
+		catenaryInputs[index] = randomStream.FRandRange(RyFastMath::ExpMin, RyFastMath::ExpMax) * catenaryScalingFactor;
+		angleInputs[index] = randomStream.FRandRange(-1000.0f, 1000.0f);
+		ys[index] = randomStream.FRandRange(-100.0f, 100.0f);
+		xs[index] = randomStream.FRandRange(-100.0f, 100.0f);
+	}
+
+	TArray<float> output, secondOutput;
+	output.SetNumUninitialized(numElements);
+	secondOutput.SetNumUninitialized(numElements);
+
+	auto timePasses = [iterations](TFunctionRef<void()> pass)
+	{
+		const double startTime = FPlatformTime::Seconds();
+		for(int32 iteration = 0; iteration < iterations; ++iteration)
+		{
+			pass();
+		}
+		return static_cast<float>((FPlatformTime::Seconds() - startTime) * 1000.0 / iterations);
+	};
+
+	// Times all three paths, leaving the batch results in output for the error check
+	auto measure = [&](const TCHAR* function, TFunctionRef<void()> libmPass, TFunctionRef<void()> fastPass, TFunctionRef<void()> batchPass,
+	                   TFunctionRef<double(int32)> reference, const TArray<float>& measured)
+	{
+		FRyFastMathBenchmarkResult& result = results.AddDefaulted_GetRef();
+		result.Function = function;
+		result.LibmMilliseconds = timePasses(libmPass);
+		result.FastMilliseconds = timePasses(fastPass);
+		result.FastBatchMilliseconds = timePasses(batchPass);
+
+		double maxAbsoluteError = 0.0, maxRelativeError = 0.0;
+		for(int32 index = 0; index < numElements; ++index)
+		{
+			const double expected = reference(index);
+			const double error = FMath::Abs(static_cast<double>(measured[index]) - expected);
+			maxAbsoluteError = FMath::Max(maxAbsoluteError, error);
+			if(expected != 0.0)
+			{
+				maxRelativeError = FMath::Max(maxRelativeError, error / FMath::Abs(expected));
+			}
+		}
+		result.MaxAbsoluteError = static_cast<float>(maxAbsoluteError);
+		result.MaxRelativeError = static_cast<float>(maxRelativeError);
+
+		UE_LOG(LogRyRuntime, Log, TEXT("BenchmarkFastMath: %-10s libm %.3fms fast %.3fms batch %.3fms | max abs error %g max rel error %g"),
+			function, result.LibmMilliseconds, result.FastMilliseconds, result.FastBatchMilliseconds, result.MaxAbsoluteError, result.MaxRelativeError);
+	};
+
+	measure(TEXT("SinH"),
+		[&]() { for(int32 index = 0; index < numElements; ++index) { output[index] = sinhf(hyperbolicInputs[index]); } },
+		[&]() { for(int32 index = 0; index < numElements; ++index) { output[index] = FastSinH(hyperbolicInputs[index]); } },
+		[&]() { FastSinHBatch(hyperbolicInputs.GetData(), output.GetData(), numElements); },
+		[&](const int32 index) { return sinh(static_cast<double>(hyperbolicInputs[index])); }, output);
+
+	measure(TEXT("CosH"),
+		[&]() { for(int32 index = 0; index < numElements; ++index) { output[index] = coshf(hyperbolicInputs[index]); } },
+		[&]() { for(int32 index = 0; index < numElements; ++index) { output[index] = FastCosH(hyperbolicInputs[index]); } },
+		[&]() { FastCosHBatch(hyperbolicInputs.GetData(), output.GetData(), numElements); },
+		[&](const int32 index) { return cosh(static_cast<double>(hyperbolicInputs[index])); }, output);
+
+	measure(TEXT("SinCos/Sin"),
+		[&]() { for(int32 index = 0; index < numElements; ++index) { output[index] = sinf(angleInputs[index]); secondOutput[index] = cosf(angleInputs[index]); } },
+		[&]() { for(int32 index = 0; index < numElements; ++index) { FastSinCos(angleInputs[index], output[index], secondOutput[index]); } },
+		[&]() { FastSinCosBatch(angleInputs.GetData(), output.GetData(), secondOutput.GetData(), numElements); },
+		[&](const int32 index) { return sin(static_cast<double>(angleInputs[index])); }, output);
+
+	measure(TEXT("SinCos/Cos"),
+		[&]() { for(int32 index = 0; index < numElements; ++index) { output[index] = sinf(angleInputs[index]); secondOutput[index] = cosf(angleInputs[index]); } },
+		[&]() { for(int32 index = 0; index < numElements; ++index) { FastSinCos(angleInputs[index], output[index], secondOutput[index]); } },
+		[&]() { FastSinCosBatch(angleInputs.GetData(), output.GetData(), secondOutput.GetData(), numElements); },
+		[&](const int32 index) { return cos(static_cast<double>(angleInputs[index])); }, secondOutput);
+
+	measure(TEXT("Atan2"),
+		[&]() { for(int32 index = 0; index < numElements; ++index) { output[index] = FMath::Atan2(ys[index], xs[index]); } },
+		[&]() { for(int32 index = 0; index < numElements; ++index) { output[index] = FastAtan2(ys[index], xs[index]); } },
+		[&]() { FastAtan2Batch(ys.GetData(), xs.GetData(), output.GetData(), numElements); },
+		[&](const int32 index) { return atan2(static_cast<double>(ys[index]), static_cast<double>(xs[index])); }, output);
+
+	measure(TEXT("Catenary"),
+		[&]() { for(int32 index = 0; index < numElements; ++index) { output[index] = CalculateCatenary(catenaryInputs[index], catenaryScalingFactor); } },
+		[&]() { for(int32 index = 0; index < numElements; ++index) { output[index] = FastCalculateCatenary(catenaryInputs[index], catenaryScalingFactor); } },
+		[&]() { FastCalculateCatenaryBatch(catenaryInputs.GetData(), catenaryScalingFactor, output.GetData(), numElements); },
+		[&](const int32 index) { return catenaryScalingFactor * cosh(static_cast<double>(catenaryInputs[index]) / catenaryScalingFactor); }, output);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * Sum of the 4 lanes of a register
+*/
+static FORCEINLINE float VectorHorizontalSum(const VectorRegister& vec)
+{
+	float lanes[4];
+	VectorStore(vec, lanes);
+	return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * Shared search for MinFloatArray and MaxFloatArray. Returns the value and index of the first element for which
+ * no other element is 'better', as decided by vectorBetter / scalarBetter (strict comparisons).
+*/
+template<typename VectorBetterType, typename ScalarBetterType>
+static float FindExtremeFloat(const TArray<float>& values, int32& extremeIndex, VectorBetterType vectorBetter, ScalarBetterType scalarBetter)
+{
+	const int32 num = values.Num();
+	if(num == 0)
+	{
+		extremeIndex = INDEX_NONE;
+		return 0.0f;
+	}
+
+	const float* src = values.GetData();
+	float best = src[0];
+	extremeIndex = 0;
+
+	// Lane indices are tracked as floats to share VectorSelect, which is exact up to 2^24
+	int32 index = 0;
+	if(num >= 8 && num <= (1 << 24))
+	{
+		VectorRegister laneBest = VectorLoad(src);
+		VectorRegister laneBestIndices = MakeVectorRegister(0.0f, 1.0f, 2.0f, 3.0f);
+		VectorRegister laneIndices = laneBestIndices;
+		const VectorRegister indexStep = VectorSetFloat1(4.0f);
+
+		for(index = 4; index + 4 <= num; index += 4)
+		{
+			laneIndices = VectorAdd(laneIndices, indexStep);
+			const VectorRegister current = VectorLoad(src + index);
+			const VectorRegister better = vectorBetter(current, laneBest);
+			laneBest = VectorSelect(better, current, laneBest);
+			laneBestIndices = VectorSelect(better, laneIndices, laneBestIndices);
+		}
+
+		float lanes[4], laneIndexValues[4];
+		VectorStore(laneBest, lanes);
+		VectorStore(laneBestIndices, laneIndexValues);
+		best = lanes[0];
+		extremeIndex = static_cast<int32>(laneIndexValues[0]);
+		for(int32 lane = 1; lane < 4; ++lane)
+		{
+			const int32 laneIndex = static_cast<int32>(laneIndexValues[lane]);
+			if(scalarBetter(lanes[lane], best) || (lanes[lane] == best && laneIndex < extremeIndex))
+			{
+				best = lanes[lane];
+				extremeIndex = laneIndex;
+			}
+		}
+	}
+
+	for(; index < num; ++index)
+	{
+		if(scalarBetter(src[index], best))
+		{
+			best = src[index];
+			extremeIndex = index;
+		}
+	}
+	return best;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * Applies an element wise transform to values in place, 4 at a time
+*/
+template<typename VectorOpType, typename ScalarOpType>
+static FORCEINLINE void TransformFloatArray(float* values, const int32 num, VectorOpType vectorOp, ScalarOpType scalarOp)
+{
+	int32 index = 0;
+	for(; index + 4 <= num; index += 4)
+	{
+		VectorStore(vectorOp(VectorLoad(values + index)), values + index);
+	}
+	for(; index < num; ++index)
+	{
+		values[index] = scalarOp(values[index]);
+	}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+float URyRuntimeMathHelpers::SumFloatArray(const TArray<float>& values)
+{
+	const float* src = values.GetData();
+	const int32 num = values.Num();
+
+	// Two accumulators to hide the add latency
+	VectorRegister sumA = VectorZero();
+	VectorRegister sumB = VectorZero();
+	int32 index = 0;
+	for(; index + 8 <= num; index += 8)
+	{
+		sumA = VectorAdd(sumA, VectorLoad(src + index));
+		sumB = VectorAdd(sumB, VectorLoad(src + index + 4));
+	}
+	for(; index + 4 <= num; index += 4)
+	{
+		sumA = VectorAdd(sumA, VectorLoad(src + index));
+	}
+
+	float sum = VectorHorizontalSum(VectorAdd(sumA, sumB));
+	for(; index < num; ++index)
+	{
+		sum += src[index];
+	}
+	return sum;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+float URyRuntimeMathHelpers::MinFloatArray(const TArray<float>& values, int32& minIndex)
+{
+	return FindExtremeFloat(values, minIndex,
+		[](const VectorRegister& a, const VectorRegister& b) { return VectorCompareGT(b, a); },
+		[](const float a, const float b) { return a < b; });
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+float URyRuntimeMathHelpers::MaxFloatArray(const TArray<float>& values, int32& maxIndex)
+{
+	return FindExtremeFloat(values, maxIndex,
+		[](const VectorRegister& a, const VectorRegister& b) { return VectorCompareGT(a, b); },
+		[](const float a, const float b) { return a > b; });
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+float URyRuntimeMathHelpers::MeanFloatArray(const TArray<float>& values)
+{
+	return values.Num() > 0 ? SumFloatArray(values) / values.Num() : 0.0f;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+float URyRuntimeMathHelpers::VarianceFloatArray(const TArray<float>& values, float& mean, const bool sample)
+{
+	mean = MeanFloatArray(values);
+	const int32 num = values.Num();
+	const int32 divisor = sample ? num - 1 : num;
+	if(divisor <= 0)
+	{
+		return 0.0f;
+	}
+
+	// Two pass (mean first) to avoid the cancellation of sum(x^2) - sum(x)^2 / n
+	const float* src = values.GetData();
+	const VectorRegister meanVec = VectorSetFloat1(mean);
+	VectorRegister sumSquares = VectorZero();
+	int32 index = 0;
+	for(; index + 4 <= num; index += 4)
+	{
+		const VectorRegister delta = VectorSubtract(VectorLoad(src + index), meanVec);
+		sumSquares = VectorMultiplyAdd(delta, delta, sumSquares);
+	}
+
+	float sum = VectorHorizontalSum(sumSquares);
+	for(; index < num; ++index)
+	{
+		sum += FMath::Square(src[index] - mean);
+	}
+	return sum / divisor;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeMathHelpers::ScaleFloatArrayInline(TArray<float>& values, const float scale)
+{
+	const VectorRegister scaleVec = VectorSetFloat1(scale);
+	TransformFloatArray(values.GetData(), values.Num(),
+		[&scaleVec](const VectorRegister& value) { return VectorMultiply(value, scaleVec); },
+		[scale](const float value) { return value * scale; });
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeMathHelpers::OffsetFloatArrayInline(TArray<float>& values, const float offset)
+{
+	const VectorRegister offsetVec = VectorSetFloat1(offset);
+	TransformFloatArray(values.GetData(), values.Num(),
+		[&offsetVec](const VectorRegister& value) { return VectorAdd(value, offsetVec); },
+		[offset](const float value) { return value + offset; });
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeMathHelpers::ClampFloatArrayInline(TArray<float>& values, const float min, const float max)
+{
+	const VectorRegister minVec = VectorSetFloat1(min);
+	const VectorRegister maxVec = VectorSetFloat1(max);
+	TransformFloatArray(values.GetData(), values.Num(),
+		[&minVec, &maxVec](const VectorRegister& value) { return VectorMin(VectorMax(value, minVec), maxVec); },
+		[min, max](const float value) { return FMath::Min(FMath::Max(value, min), max); });
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeMathHelpers::LerpFloatArrayInline(TArray<float>& values, const TArray<float>& targets, const float alpha)
+{
+	if(values.Num() != targets.Num())
+	{
+		UE_LOG(LogRyRuntime, Warning, TEXT("LerpFloatArrayInline: values and targets must be the same length"));
+		return;
+	}
+
+	float* dst = values.GetData();
+	const float* src = targets.GetData();
+	const int32 num = values.Num();
+	const VectorRegister alphaVec = VectorSetFloat1(alpha);
+
+	int32 index = 0;
+	for(; index + 4 <= num; index += 4)
+	{
+		const VectorRegister value = VectorLoad(dst + index);
+		VectorStore(VectorMultiplyAdd(VectorSubtract(VectorLoad(src + index), value), alphaVec, value), dst + index);
+	}
+	for(; index < num; ++index)
+	{
+		dst[index] = FMath::Lerp(dst[index], src[index], alpha);
+	}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeMathHelpers::NormalizeFloatArrayInline(TArray<float>& values)
+{
+	int32 minIndex, maxIndex;
+	const float min = MinFloatArray(values, minIndex);
+	const float max = MaxFloatArray(values, maxIndex);
+	const float range = max - min;
+	if(range <= 0.0f)
+	{
+		FMemory::Memzero(values.GetData(), values.Num() * sizeof(float));
+		return;
+	}
+
+	// (value - min) / range as one multiply add
+	const float scale = 1.0f / range;
+	const float offset = -min * scale;
+	const VectorRegister scaleVec = VectorSetFloat1(scale);
+	const VectorRegister offsetVec = VectorSetFloat1(offset);
+	TransformFloatArray(values.GetData(), values.Num(),
+		[&scaleVec, &offsetVec](const VectorRegister& value) { return VectorMultiplyAdd(value, scaleVec, offsetVec); },
+		[scale, offset](const float value) { return value * scale + offset; });
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * Maps a float to a uint32 which sorts in the same order: flip the sign bit of positives, and every bit of negatives
+*/
+static FORCEINLINE uint32 FloatToRadixKey(const float value, const bool descending)
+{
+	uint32 bits;
+	FMemory::Memcpy(&bits, &value, sizeof(float));
+	const uint32 key = bits ^ (static_cast<uint32>(static_cast<int32>(bits) >> 31) | 0x80000000u);
+	return descending ? ~key : key;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * Maps an int32 to a uint32 which sorts in the same order
+*/
+static FORCEINLINE uint32 IntToRadixKey(const int32 value, const bool descending)
+{
+	const uint32 key = static_cast<uint32>(value) ^ 0x80000000u;
+	return descending ? ~key : key;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * Stable LSD radix sort of radixKeys, 8 bits per pass, carrying indices along. Both arrays are sorted in place.
+*/
+static void RadixSortKeysAndIndices(TArray<uint32>& radixKeys, TArray<int32>& indices)
+{
+	const int32 num = radixKeys.Num();
+	if(num <= 1)
+	{
+		return;
+	}
+
+	// Histograms of all 4 digits in one pass
+	uint32 histograms[4][256];
+	FMemory::Memzero(histograms, sizeof(histograms));
+	for(const uint32 key : radixKeys)
+	{
+		++histograms[0][key & 0xFF];
+		++histograms[1][(key >> 8) & 0xFF];
+		++histograms[2][(key >> 16) & 0xFF];
+		++histograms[3][key >> 24];
+	}
+
+	TArray<uint32> scratchKeys;
+	TArray<int32> scratchIndices;
+	scratchKeys.SetNumUninitialized(num);
+	scratchIndices.SetNumUninitialized(num);
+
+	uint32* srcKeys = radixKeys.GetData();
+	int32* srcIndices = indices.GetData();
+	uint32* dstKeys = scratchKeys.GetData();
+	int32* dstIndices = scratchIndices.GetData();
+
+	for(int32 pass = 0; pass < 4; ++pass)
+	{
+		const int32 shift = pass * 8;
+		uint32* histogram = histograms[pass];
+
+		// Every key has the same digit, so this pass wouldn't move anything
+		if(histogram[(srcKeys[0] >> shift) & 0xFF] == static_cast<uint32>(num))
+		{
+			continue;
+		}
+
+		uint32 offset = 0;
+		for(int32 digit = 0; digit < 256; ++digit)
+		{
+			const uint32 count = histogram[digit];
+			histogram[digit] = offset;
+			offset += count;
+		}
+
+		for(int32 index = 0; index < num; ++index)
+		{
+			const uint32 key = srcKeys[index];
+			const uint32 destination = histogram[(key >> shift) & 0xFF]++;
+			dstKeys[destination] = key;
+			dstIndices[destination] = srcIndices[index];
+		}
+
+		Swap(srcKeys, dstKeys);
+		Swap(srcIndices, dstIndices);
+	}
+
+	// An odd number of passes leaves the result in the scratch arrays
+	if(srcKeys != radixKeys.GetData())
+	{
+		FMemory::Memcpy(radixKeys.GetData(), srcKeys, num * sizeof(uint32));
+		FMemory::Memcpy(indices.GetData(), srcIndices, num * sizeof(int32));
+	}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * Sorts the indices of the k smallest radixKeys into sortedIndices
+*/
+static void RadixTopKIndices(const TArray<uint32>& radixKeys, int32 k, TArray<int32>& sortedIndices)
+{
+	const int32 num = radixKeys.Num();
+	k = FMath::Clamp(k, 0, num);
+	sortedIndices.Reset(k);
+	if(k == 0)
+	{
+		return;
+	}
+
+	// Radix select the k-th smallest key (the threshold) a byte at a time from the top, only counting keys which
+	// match the threshold bytes found so far. 'remaining' ends as how many keys equal to the threshold are needed.
+	uint32 threshold = 0;
+	uint32 thresholdMask = 0;
+	int32 remaining = k;
+	for(int32 shift = 24; shift >= 0; shift -= 8)
+	{
+		int32 histogram[256];
+		FMemory::Memzero(histogram, sizeof(histogram));
+		for(const uint32 key : radixKeys)
+		{
+			if((key & thresholdMask) == threshold)
+			{
+				++histogram[(key >> shift) & 0xFF];
+			}
+		}
+
+		uint32 digit = 0;
+		while(histogram[digit] < remaining)
+		{
+			remaining -= histogram[digit];
+			++digit;
+		}
+		threshold |= digit << shift;
+		thresholdMask |= 0xFFu << shift;
+	}
+
+	// Gather in index order, so ties at the threshold are taken first come first served and the sort stays stable
+	TArray<uint32> selectedKeys;
+	selectedKeys.Reserve(k);
+	for(int32 index = 0; index < num; ++index)
+	{
+		const uint32 key = radixKeys[index];
+		if(key < threshold || (key == threshold && remaining-- > 0))
+		{
+			selectedKeys.Add(key);
+			sortedIndices.Add(index);
+		}
+	}
+
+	RadixSortKeysAndIndices(selectedKeys, sortedIndices);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeMathHelpers::SortIndicesByFloatKeys(const TArray<float>& keys, TArray<int32>& sortedIndices, const bool descending)
+{
+	const int32 num = keys.Num();
+	TArray<uint32> radixKeys;
+	radixKeys.SetNumUninitialized(num);
+	sortedIndices.SetNumUninitialized(num);
+	for(int32 index = 0; index < num; ++index)
+	{
+		radixKeys[index] = FloatToRadixKey(keys[index], descending);
+		sortedIndices[index] = index;
+	}
+	RadixSortKeysAndIndices(radixKeys, sortedIndices);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeMathHelpers::SortIndicesByIntKeys(const TArray<int32>& keys, TArray<int32>& sortedIndices, const bool descending)
+{
+	const int32 num = keys.Num();
+	TArray<uint32> radixKeys;
+	radixKeys.SetNumUninitialized(num);
+	sortedIndices.SetNumUninitialized(num);
+	for(int32 index = 0; index < num; ++index)
+	{
+		radixKeys[index] = IntToRadixKey(keys[index], descending);
+		sortedIndices[index] = index;
+	}
+	RadixSortKeysAndIndices(radixKeys, sortedIndices);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeMathHelpers::TopKIndicesByFloatKeys(const TArray<float>& keys, const int32 k, TArray<int32>& sortedIndices, const bool descending)
+{
+	TArray<uint32> radixKeys;
+	radixKeys.SetNumUninitialized(keys.Num());
+	for(int32 index = 0; index < keys.Num(); ++index)
+	{
+		radixKeys[index] = FloatToRadixKey(keys[index], descending);
+	}
+	RadixTopKIndices(radixKeys, k, sortedIndices);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeMathHelpers::TopKIndicesByIntKeys(const TArray<int32>& keys, const int32 k, TArray<int32>& sortedIndices, const bool descending)
+{
+	TArray<uint32> radixKeys;
+	radixKeys.SetNumUninitialized(keys.Num());
+	for(int32 index = 0; index < keys.Num(); ++index)
+	{
+		radixKeys[index] = IntToRadixKey(keys[index], descending);
+	}
+	RadixTopKIndices(radixKeys, k, sortedIndices);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * SIMD noise kernels, each evaluating 4 samples at once. Lattice hashing and gradient lookup are done per lane, as
+ * there are no gathers; everything else is vector math. SampleNoise runs the same kernels, so results match for the same
+ * input position. FillNoiseGrid builds positions as origin + spacing * x + lane * spacing, which can round differently
+ * from origin + spacing * (x + lane), so grid samples match SampleNoise within that rounding.
+*/
+namespace RyNoise
+{
+	// Edges of a cube, the classic improved Perlin noise gradients. Also used by simplex noise.
+	static const float Gradients3D[12][3] =
+	{
+		{1, 1, 0}, {-1, 1, 0}, {1, -1, 0}, {-1, -1, 0},
+		{1, 0, 1}, {-1, 0, 1}, {1, 0, -1}, {-1, 0, -1},
+		{0, 1, 1}, {0, -1, 1}, {0, 1, -1}, {0, -1, -1},
+	};
+
+	static const float Gradients2D[8][2] =
+	{
+		{1, 0}, {-1, 0}, {0, 1}, {0, -1},
+		{0.70710678f, 0.70710678f}, {-0.70710678f, 0.70710678f}, {0.70710678f, -0.70710678f}, {-0.70710678f, -0.70710678f},
+	};
+
+	// Scales taking each kernel's natural range to roughly [-1, 1]
+	static constexpr float Perlin1DScale = 2.0f;
+	static constexpr float Perlin2DScale = 1.41421356f;
+	static constexpr float Simplex1DScale = 0.395f;
+	static constexpr float Simplex2DScale = 70.0f;
+	static constexpr float Simplex3DScale = 32.0f;
+
+	typedef VectorRegister (*FKernel)(const VectorRegister& x, const VectorRegister& y, const VectorRegister& z, const uint32 seed);
+
+	//-----------------------------------------------------------------------------------------------------------------
+	/**
+	 * Hash a lattice point and seed into 32 well mixed bits
+	*/
+	static FORCEINLINE uint32 Hash(const int32 x, const int32 y, const int32 z, const uint32 seed)
+	{
+		uint32 hash = seed + static_cast<uint32>(x) * 0x27d4eb2du + static_cast<uint32>(y) * 0x165667b1u + static_cast<uint32>(z) * 0x9e3779b1u;
+		hash ^= hash >> 15;
+		hash *= 0x2c1b3c6du;
+		hash ^= hash >> 12;
+		hash *= 0x297a2d39u;
+		hash ^= hash >> 15;
+		return hash;
+	}
+
+	//-----------------------------------------------------------------------------------------------------------------
+	/**
+	*/
+	static FORCEINLINE VectorRegister Floor(const VectorRegister& value)
+	{
+		const VectorRegister truncated = VectorTruncate(value);
+		return VectorSelect(VectorCompareGT(truncated, value), VectorSubtract(truncated, VectorOne()), truncated);
+	}
+
+	//-----------------------------------------------------------------------------------------------------------------
+	/**
+	 * 6t^5 - 15t^4 + 10t^3
+	*/
+	static FORCEINLINE VectorRegister Fade(const VectorRegister& t)
+	{
+		const VectorRegister inner = VectorMultiplyAdd(t, VectorMultiplyAdd(t, VectorSetFloat1(6.0f), VectorSetFloat1(-15.0f)), VectorSetFloat1(10.0f));
+		return VectorMultiply(VectorMultiply(VectorMultiply(t, t), t), inner);
+	}
+
+	//-----------------------------------------------------------------------------------------------------------------
+	/**
+	*/
+	static FORCEINLINE VectorRegister Lerp(const VectorRegister& a, const VectorRegister& b, const VectorRegister& alpha)
+	{
+		return VectorMultiplyAdd(VectorSubtract(b, a), alpha, a);
+	}
+
+	//-----------------------------------------------------------------------------------------------------------------
+	/**
+	 * Lanes of an integral valued register as ints, plus an optional per lane offset
+	*/
+	static FORCEINLINE void ToLanes(const VectorRegister& value, int32 (&lanesOut)[4], const VectorRegister* offset = nullptr)
+	{
+		float lanes[4];
+		VectorStore(offset ? VectorAdd(value, *offset) : value, lanes);
+		for(int32 lane = 0; lane < 4; ++lane)
+		{
+			lanesOut[lane] = static_cast<int32>(lanes[lane]);
+		}
+	}
+
+	//-----------------------------------------------------------------------------------------------------------------
+	/**
+	*/
+	static FORCEINLINE void AddToLanes(const int32 (&lanes)[4], const int32 add, int32 (&lanesOut)[4])
+	{
+		for(int32 lane = 0; lane < 4; ++lane)
+		{
+			lanesOut[lane] = lanes[lane] + add;
+		}
+	}
+
+	//-----------------------------------------------------------------------------------------------------------------
+	/**
+	 * Random value in [-1, 1] at each lane's lattice point
+	*/
+	static FORCEINLINE VectorRegister LatticeValue(const int32 (&x)[4], const int32 (&y)[4], const int32 (&z)[4], const uint32 seed)
+	{
+		float values[4];
+		for(int32 lane = 0; lane < 4; ++lane)
+		{
+			values[lane] = static_cast<float>(Hash(x[lane], y[lane], z[lane], seed)) * (2.0f / MAX_uint32) - 1.0f;
+		}
+		return VectorLoad(values);
+	}
+
+	//-----------------------------------------------------------------------------------------------------------------
+	/**
+	 * 1D gradient (+-1 to 8) at each lane's lattice point, multiplied by offsetX
+	*/
+	static FORCEINLINE VectorRegister GradientDot1D(const int32 (&x)[4], const uint32 seed, const VectorRegister& offsetX)
+	{
+		float gradients[4];
+		for(int32 lane = 0; lane < 4; ++lane)
+		{
+			const uint32 hash = Hash(x[lane], 0, 0, seed);
+			const float gradient = static_cast<float>(1 + (hash & 7));
+			gradients[lane] = (hash & 8) ? -gradient : gradient;
+		}
+		return VectorMultiply(VectorLoad(gradients), offsetX);
+	}
+
+	//-----------------------------------------------------------------------------------------------------------------
+	/**
+	 * Dot of the gradient at each lane's lattice point with the offset from it. Uses the xy of Gradients3D for simplex.
+	*/
+	template<int32 NumGradients, int32 GradientSize>
+	static FORCEINLINE VectorRegister GradientDot2D(const float (&table)[NumGradients][GradientSize], const int32 (&x)[4], const int32 (&y)[4],
+	                                                const uint32 seed, const VectorRegister& offsetX, const VectorRegister& offsetY)
+	{
+		float gradientsX[4], gradientsY[4];
+		for(int32 lane = 0; lane < 4; ++lane)
+		{
+			const float* gradient = table[Hash(x[lane], y[lane], 0, seed) % NumGradients];
+			gradientsX[lane] = gradient[0];
+			gradientsY[lane] = gradient[1];
+		}
+		return VectorMultiplyAdd(VectorLoad(gradientsX), offsetX, VectorMultiply(VectorLoad(gradientsY), offsetY));
+	}
+
+	//-----------------------------------------------------------------------------------------------------------------
+	/**
+	*/
+	static FORCEINLINE VectorRegister GradientDot3D(const int32 (&x)[4], const int32 (&y)[4], const int32 (&z)[4], const uint32 seed,
+	                                                const VectorRegister& offsetX, const VectorRegister& offsetY, const VectorRegister& offsetZ)
+	{
+		float gradientsX[4], gradientsY[4], gradientsZ[4];
+		for(int32 lane = 0; lane < 4; ++lane)
+		{
+			const float* gradient = Gradients3D[Hash(x[lane], y[lane], z[lane], seed) % 12];
+			gradientsX[lane] = gradient[0];
+			gradientsY[lane] = gradient[1];
+			gradientsZ[lane] = gradient[2];
+		}
+		return VectorMultiplyAdd(VectorLoad(gradientsX), offsetX,
+			VectorMultiplyAdd(VectorLoad(gradientsY), offsetY, VectorMultiply(VectorLoad(gradientsZ), offsetZ)));
+	}
+
+	//-----------------------------------------------------------------------------------------------------------------
+	/**
+	 * Simplex corner falloff, max(radius - distance^2, 0)^4 * contribution
+	*/
+	static FORCEINLINE VectorRegister SimplexFalloff(const VectorRegister& radius, const VectorRegister& distanceSquared, const VectorRegister& contribution)
+	{
+		VectorRegister t = VectorMax(VectorSubtract(radius, distanceSquared), VectorZero());
+		t = VectorMultiply(t, t);
+		return VectorMultiply(VectorMultiply(t, t), contribution);
+	}
+
+	//-----------------------------------------------------------------------------------------------------------------
+	/**
+	*/
+	static VectorRegister Value1D(const VectorRegister& x, const VectorRegister&, const VectorRegister&, const uint32 seed)
+	{
+		const VectorRegister cellX = Floor(x);
+		int32 x0[4], x1[4], zero[4] = {0, 0, 0, 0};
+		ToLanes(cellX, x0);
+		AddToLanes(x0, 1, x1);
+		return Lerp(LatticeValue(x0, zero, zero, seed), LatticeValue(x1, zero, zero, seed), Fade(VectorSubtract(x, cellX)));
+	}
+
+	//-----------------------------------------------------------------------------------------------------------------
+	/**
+	*/
+	static VectorRegister Value2D(const VectorRegister& x, const VectorRegister& y, const VectorRegister&, const uint32 seed)
+	{
+		const VectorRegister cellX = Floor(x);
+		const VectorRegister cellY = Floor(y);
+		int32 x0[4], x1[4], y0[4], y1[4], zero[4] = {0, 0, 0, 0};
+		ToLanes(cellX, x0);
+		ToLanes(cellY, y0);
+		AddToLanes(x0, 1, x1);
+		AddToLanes(y0, 1, y1);
+
+		const VectorRegister u = Fade(VectorSubtract(x, cellX));
+		const VectorRegister v = Fade(VectorSubtract(y, cellY));
+		return Lerp(Lerp(LatticeValue(x0, y0, zero, seed), LatticeValue(x1, y0, zero, seed), u),
+		            Lerp(LatticeValue(x0, y1, zero, seed), LatticeValue(x1, y1, zero, seed), u), v);
+	}
+
+	//-----------------------------------------------------------------------------------------------------------------
+	/**
+	*/
+	static VectorRegister Value3D(const VectorRegister& x, const VectorRegister& y, const VectorRegister& z, const uint32 seed)
+	{
+		const VectorRegister cellX = Floor(x);
+		const VectorRegister cellY = Floor(y);
+		const VectorRegister cellZ = Floor(z);
+		int32 x0[4], x1[4], y0[4], y1[4], z0[4], z1[4];
+		ToLanes(cellX, x0);
+		ToLanes(cellY, y0);
+		ToLanes(cellZ, z0);
+		AddToLanes(x0, 1, x1);
+		AddToLanes(y0, 1, y1);
+		AddToLanes(z0, 1, z1);
+
+		const VectorRegister u = Fade(VectorSubtract(x, cellX));
+		const VectorRegister v = Fade(VectorSubtract(y, cellY));
+		const VectorRegister w = Fade(VectorSubtract(z, cellZ));
+		return Lerp(Lerp(Lerp(LatticeValue(x0, y0, z0, seed), LatticeValue(x1, y0, z0, seed), u),
+		                 Lerp(LatticeValue(x0, y1, z0, seed), LatticeValue(x1, y1, z0, seed), u), v),
+		            Lerp(Lerp(LatticeValue(x0, y0, z1, seed), LatticeValue(x1, y0, z1, seed), u),
+		                 Lerp(LatticeValue(x0, y1, z1, seed), LatticeValue(x1, y1, z1, seed), u), v), w);
+	}
+
+	//-----------------------------------------------------------------------------------------------------------------
+	/**
+	*/
+	static VectorRegister Perlin1D(const VectorRegister& x, const VectorRegister&, const VectorRegister&, const uint32 seed)
+	{
+		const VectorRegister cellX = Floor(x);
+		const VectorRegister fx = VectorSubtract(x, cellX);
+		int32 x0[4], x1[4];
+		ToLanes(cellX, x0);
+		AddToLanes(x0, 1, x1);
+
+		// 1D gradients run to 8, so scale them back to 1 along with the range
+		const VectorRegister noise = Lerp(GradientDot1D(x0, seed, fx), GradientDot1D(x1, seed, VectorSubtract(fx, VectorOne())), Fade(fx));
+		return VectorMultiply(noise, VectorSetFloat1(Perlin1DScale / 8.0f));
+	}
+
+	//-----------------------------------------------------------------------------------------------------------------
+	/**
+	*/
+	static VectorRegister Perlin2D(const VectorRegister& x, const VectorRegister& y, const VectorRegister&, const uint32 seed)
+	{
+		const VectorRegister one = VectorOne();
+		const VectorRegister cellX = Floor(x);
+		const VectorRegister cellY = Floor(y);
+		const VectorRegister fx0 = VectorSubtract(x, cellX);
+		const VectorRegister fy0 = VectorSubtract(y, cellY);
+		const VectorRegister fx1 = VectorSubtract(fx0, one);
+		const VectorRegister fy1 = VectorSubtract(fy0, one);
+		int32 x0[4], x1[4], y0[4], y1[4];
+		ToLanes(cellX, x0);
+		ToLanes(cellY, y0);
+		AddToLanes(x0, 1, x1);
+		AddToLanes(y0, 1, y1);
+
+		const VectorRegister u = Fade(fx0);
+		const VectorRegister v = Fade(fy0);
+		const VectorRegister noise = Lerp(Lerp(GradientDot2D(Gradients2D, x0, y0, seed, fx0, fy0), GradientDot2D(Gradients2D, x1, y0, seed, fx1, fy0), u),
+		                                  Lerp(GradientDot2D(Gradients2D, x0, y1, seed, fx0, fy1), GradientDot2D(Gradients2D, x1, y1, seed, fx1, fy1), u), v);
+		return VectorMultiply(noise, VectorSetFloat1(Perlin2DScale));
+	}
+
+	//-----------------------------------------------------------------------------------------------------------------
+	/**
+	*/
+	static VectorRegister Perlin3D(const VectorRegister& x, const VectorRegister& y, const VectorRegister& z, const uint32 seed)
+	{
+		const VectorRegister one = VectorOne();
+		const VectorRegister cellX = Floor(x);
+		const VectorRegister cellY = Floor(y);
+		const VectorRegister cellZ = Floor(z);
+		const VectorRegister fx0 = VectorSubtract(x, cellX);
+		const VectorRegister fy0 = VectorSubtract(y, cellY);
+		const VectorRegister fz0 = VectorSubtract(z, cellZ);
+		const VectorRegister fx1 = VectorSubtract(fx0, one);
+		const VectorRegister fy1 = VectorSubtract(fy0, one);
+		const VectorRegister fz1 = VectorSubtract(fz0, one);
+		int32 x0[4], x1[4], y0[4], y1[4], z0[4], z1[4];
+		ToLanes(cellX, x0);
+		ToLanes(cellY, y0);
+		ToLanes(cellZ, z0);
+		AddToLanes(x0, 1, x1);
+		AddToLanes(y0, 1, y1);
+		AddToLanes(z0, 1, z1);
+
+		const VectorRegister u = Fade(fx0);
+		const VectorRegister v = Fade(fy0);
+		const VectorRegister w = Fade(fz0);
+		return Lerp(Lerp(Lerp(GradientDot3D(x0, y0, z0, seed, fx0, fy0, fz0), GradientDot3D(x1, y0, z0, seed, fx1, fy0, fz0), u),
+		                 Lerp(GradientDot3D(x0, y1, z0, seed, fx0, fy1, fz0), GradientDot3D(x1, y1, z0, seed, fx1, fy1, fz0), u), v),
+		            Lerp(Lerp(GradientDot3D(x0, y0, z1, seed, fx0, fy0, fz1), GradientDot3D(x1, y0, z1, seed, fx1, fy0, fz1), u),
+		                 Lerp(GradientDot3D(x0, y1, z1, seed, fx0, fy1, fz1), GradientDot3D(x1, y1, z1, seed, fx1, fy1, fz1), u), v), w);
+	}
+
+	//-----------------------------------------------------------------------------------------------------------------
+	/**
+	*/
+	static VectorRegister Simplex1D(const VectorRegister& x, const VectorRegister&, const VectorRegister&, const uint32 seed)
+	{
+		const VectorRegister one = VectorOne();
+		const VectorRegister cellX = Floor(x);
+		const VectorRegister x0 = VectorSubtract(x, cellX);
+		const VectorRegister x1 = VectorSubtract(x0, one);
+		int32 i0[4], i1[4];
+		ToLanes(cellX, i0);
+		AddToLanes(i0, 1, i1);
+
+		const VectorRegister n0 = SimplexFalloff(one, VectorMultiply(x0, x0), GradientDot1D(i0, seed, x0));
+		const VectorRegister n1 = SimplexFalloff(one, VectorMultiply(x1, x1), GradientDot1D(i1, seed, x1));
+		return VectorMultiply(VectorAdd(n0, n1), VectorSetFloat1(Simplex1DScale));
+	}
+
+	//-----------------------------------------------------------------------------------------------------------------
+	/**
+	*/
+	static VectorRegister Simplex2D(const VectorRegister& x, const VectorRegister& y, const VectorRegister&, const uint32 seed)
+	{
+		const float skew = 0.36602540378f;   // (sqrt(3) - 1) / 2
+		const float unskew = 0.21132486540f; // (3 - sqrt(3)) / 6
+		const VectorRegister one = VectorOne();
+		const VectorRegister unskewVec = VectorSetFloat1(unskew);
+
+		// Find the simplex cell, and the offset from its first corner
+		const VectorRegister s = VectorMultiply(VectorAdd(x, y), VectorSetFloat1(skew));
+		const VectorRegister cellI = Floor(VectorAdd(x, s));
+		const VectorRegister cellJ = Floor(VectorAdd(y, s));
+		const VectorRegister t = VectorMultiply(VectorAdd(cellI, cellJ), unskewVec);
+		const VectorRegister x0 = VectorSubtract(x, VectorSubtract(cellI, t));
+		const VectorRegister y0 = VectorSubtract(y, VectorSubtract(cellJ, t));
+
+		// The middle corner steps along whichever axis the offset is larger in
+		const VectorRegister stepI = VectorBitwiseAnd(VectorCompareGT(x0, y0), one);
+		const VectorRegister stepJ = VectorSubtract(one, stepI);
+		const VectorRegister x1 = VectorAdd(VectorSubtract(x0, stepI), unskewVec);
+		const VectorRegister y1 = VectorAdd(VectorSubtract(y0, stepJ), unskewVec);
+		const VectorRegister twoUnskewMinusOne = VectorSetFloat1(2.0f * unskew - 1.0f);
+		const VectorRegister x2 = VectorAdd(x0, twoUnskewMinusOne);
+		const VectorRegister y2 = VectorAdd(y0, twoUnskewMinusOne);
+
+		int32 i0[4], j0[4], i1[4], j1[4], i2[4], j2[4];
+		ToLanes(cellI, i0);
+		ToLanes(cellJ, j0);
+		ToLanes(cellI, i1, &stepI);
+		ToLanes(cellJ, j1, &stepJ);
+		AddToLanes(i0, 1, i2);
+		AddToLanes(j0, 1, j2);
+
+		const VectorRegister radius = VectorSetFloat1(0.5f);
+		const VectorRegister n0 = SimplexFalloff(radius, VectorMultiplyAdd(x0, x0, VectorMultiply(y0, y0)), GradientDot2D(Gradients3D, i0, j0, seed, x0, y0));
+		const VectorRegister n1 = SimplexFalloff(radius, VectorMultiplyAdd(x1, x1, VectorMultiply(y1, y1)), GradientDot2D(Gradients3D, i1, j1, seed, x1, y1));
+		const VectorRegister n2 = SimplexFalloff(radius, VectorMultiplyAdd(x2, x2, VectorMultiply(y2, y2)), GradientDot2D(Gradients3D, i2, j2, seed, x2, y2));
+		return VectorMultiply(VectorAdd(VectorAdd(n0, n1), n2), VectorSetFloat1(Simplex2DScale));
+	}
+
+	//-----------------------------------------------------------------------------------------------------------------
+	/**
+	*/
+	static VectorRegister Simplex3D(const VectorRegister& x, const VectorRegister& y, const VectorRegister& z, const uint32 seed)
+	{
+		const float unskew = 1.0f / 6.0f;
+		const VectorRegister one = VectorOne();
+		const VectorRegister unskewVec = VectorSetFloat1(unskew);
+
+		// Find the simplex cell, and the offset from its first corner
+		const VectorRegister s = VectorMultiply(VectorAdd(VectorAdd(x, y), z), VectorSetFloat1(1.0f / 3.0f));
+		const VectorRegister cellI = Floor(VectorAdd(x, s));
+		const VectorRegister cellJ = Floor(VectorAdd(y, s));
+		const VectorRegister cellK = Floor(VectorAdd(z, s));
+		const VectorRegister t = VectorMultiply(VectorAdd(VectorAdd(cellI, cellJ), cellK), unskewVec);
+		const VectorRegister x0 = VectorSubtract(x, VectorSubtract(cellI, t));
+		const VectorRegister y0 = VectorSubtract(y, VectorSubtract(cellJ, t));
+		const VectorRegister z0 = VectorSubtract(z, VectorSubtract(cellK, t));
+
+		// The second corner steps along the largest offset axis, the third along all but the smallest
+		const VectorRegister xGEy = VectorCompareGE(x0, y0);
+		const VectorRegister xGEz = VectorCompareGE(x0, z0);
+		const VectorRegister yGTx = VectorCompareGT(y0, x0);
+		const VectorRegister yGEz = VectorCompareGE(y0, z0);
+		const VectorRegister zGTx = VectorCompareGT(z0, x0);
+		const VectorRegister zGTy = VectorCompareGT(z0, y0);
+		const VectorRegister stepI1 = VectorBitwiseAnd(VectorBitwiseAnd(xGEy, xGEz), one);
+		const VectorRegister stepJ1 = VectorBitwiseAnd(VectorBitwiseAnd(yGTx, yGEz), one);
+		const VectorRegister stepK1 = VectorBitwiseAnd(VectorBitwiseAnd(zGTx, zGTy), one);
+		const VectorRegister stepI2 = VectorBitwiseAnd(VectorBitwiseOr(xGEy, xGEz), one);
+		const VectorRegister stepJ2 = VectorBitwiseAnd(VectorBitwiseOr(yGTx, yGEz), one);
+		const VectorRegister stepK2 = VectorBitwiseAnd(VectorBitwiseOr(zGTx, zGTy), one);
+
+		const VectorRegister x1 = VectorAdd(VectorSubtract(x0, stepI1), unskewVec);
+		const VectorRegister y1 = VectorAdd(VectorSubtract(y0, stepJ1), unskewVec);
+		const VectorRegister z1 = VectorAdd(VectorSubtract(z0, stepK1), unskewVec);
+		const VectorRegister twoUnskew = VectorSetFloat1(2.0f * unskew);
+		const VectorRegister x2 = VectorAdd(VectorSubtract(x0, stepI2), twoUnskew);
+		const VectorRegister y2 = VectorAdd(VectorSubtract(y0, stepJ2), twoUnskew);
+		const VectorRegister z2 = VectorAdd(VectorSubtract(z0, stepK2), twoUnskew);
+		const VectorRegister threeUnskewMinusOne = VectorSetFloat1(3.0f * unskew - 1.0f);
+		const VectorRegister x3 = VectorAdd(x0, threeUnskewMinusOne);
+		const VectorRegister y3 = VectorAdd(y0, threeUnskewMinusOne);
+		const VectorRegister z3 = VectorAdd(z0, threeUnskewMinusOne);
+
+		int32 i0[4], j0[4], k0[4], i1[4], j1[4], k1[4], i2[4], j2[4], k2[4], i3[4], j3[4], k3[4];
+		ToLanes(cellI, i0);
+		ToLanes(cellJ, j0);
+		ToLanes(cellK, k0);
+		ToLanes(cellI, i1, &stepI1);
+		ToLanes(cellJ, j1, &stepJ1);
+		ToLanes(cellK, k1, &stepK1);
+		ToLanes(cellI, i2, &stepI2);
+		ToLanes(cellJ, j2, &stepJ2);
+		ToLanes(cellK, k2, &stepK2);
+		AddToLanes(i0, 1, i3);
+		AddToLanes(j0, 1, j3);
+		AddToLanes(k0, 1, k3);
+
+		auto distanceSquared = [](const VectorRegister& dx, const VectorRegister& dy, const VectorRegister& dz)
+		{
+			return VectorMultiplyAdd(dx, dx, VectorMultiplyAdd(dy, dy, VectorMultiply(dz, dz)));
+		};
+
+		const VectorRegister radius = VectorSetFloat1(0.6f);
+		const VectorRegister n0 = SimplexFalloff(radius, distanceSquared(x0, y0, z0), GradientDot3D(i0, j0, k0, seed, x0, y0, z0));
+		const VectorRegister n1 = SimplexFalloff(radius, distanceSquared(x1, y1, z1), GradientDot3D(i1, j1, k1, seed, x1, y1, z1));
+		const VectorRegister n2 = SimplexFalloff(radius, distanceSquared(x2, y2, z2), GradientDot3D(i2, j2, k2, seed, x2, y2, z2));
+		const VectorRegister n3 = SimplexFalloff(radius, distanceSquared(x3, y3, z3), GradientDot3D(i3, j3, k3, seed, x3, y3, z3));
+		return VectorMultiply(VectorAdd(VectorAdd(n0, n1), VectorAdd(n2, n3)), VectorSetFloat1(Simplex3DScale));
+	}
+
+	//-----------------------------------------------------------------------------------------------------------------
+	/**
+	*/
+	static FKernel GetKernel(const ERyNoiseType noiseType, const int32 numDimensions)
+	{
+		static const FKernel kernels[3][3] =
+		{
+			{&Value1D, &Value2D, &Value3D},
+			{&Perlin1D, &Perlin2D, &Perlin3D},
+			{&Simplex1D, &Simplex2D, &Simplex3D},
+		};
+		return kernels[FMath::Clamp(static_cast<int32>(noiseType), 0, 2)][FMath::Clamp(numDimensions, 1, 3) - 1];
+	}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+float URyRuntimeMathHelpers::SampleNoise(const ERyNoiseType noiseType, const FVector& position, const int32 seed, const int32 numDimensions)
+{
+	const RyNoise::FKernel kernel = RyNoise::GetKernel(noiseType, numDimensions);
+	float lanes[4];
+	VectorStore(kernel(VectorSetFloat1(position.X), VectorSetFloat1(position.Y), VectorSetFloat1(position.Z), static_cast<uint32>(seed)), lanes);
+	return lanes[0];
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeMathHelpers::FillNoiseGrid(const ERyNoiseType noiseType, const FIntVector& gridSize, const FVector& origin, const FVector& sampleSpacing,
+                                          TArray<float>& valuesOut, const int32 seed, const int32 numDimensions, const bool allowParallel)
+{
+	const int64 numSamples = static_cast<int64>(gridSize.X) * gridSize.Y * gridSize.Z;
+	if(gridSize.X <= 0 || gridSize.Y <= 0 || gridSize.Z <= 0 || numSamples > MAX_int32)
+	{
+		UE_LOG(LogRyRuntime, Warning, TEXT("FillNoiseGrid: Invalid grid size %s"), *gridSize.ToString());
+		valuesOut.Reset();
+		return;
+	}
+
+	valuesOut.SetNumUninitialized(static_cast<int32>(numSamples));
+	const RyNoise::FKernel kernel = RyNoise::GetKernel(noiseType, numDimensions);
+	const uint32 hashSeed = static_cast<uint32>(seed);
+
+	// Work is split into runs of up to RunLength samples along X, so a long 1D grid can still go wide
+	const int32 RunLength = 1024;
+	const int32 runsPerRow = FMath::DivideAndRoundUp(gridSize.X, RunLength);
+	const int32 numRuns = runsPerRow * gridSize.Y * gridSize.Z;
+	const VectorRegister laneOffsets = VectorMultiply(MakeVectorRegister(0.0f, 1.0f, 2.0f, 3.0f), VectorSetFloat1(sampleSpacing.X));
+	float* values = valuesOut.GetData();
+
+	auto fillRun = [&](const int32 runIndex)
+	{
+		const int32 row = runIndex / runsPerRow;
+		const int32 startX = (runIndex % runsPerRow) * RunLength;
+		const int32 endX = FMath::Min(startX + RunLength, gridSize.X);
+		const int32 y = row % gridSize.Y;
+		const int32 z = row / gridSize.Y;
+
+		const VectorRegister sampleY = VectorSetFloat1(origin.Y + sampleSpacing.Y * y);
+		const VectorRegister sampleZ = VectorSetFloat1(origin.Z + sampleSpacing.Z * z);
+		float* rowValues = values + static_cast<int64>(row) * gridSize.X;
+
+		int32 x = startX;
+		for(; x + 4 <= endX; x += 4)
+		{
+			const VectorRegister sampleX = VectorAdd(VectorSetFloat1(origin.X + sampleSpacing.X * x), laneOffsets);
+			VectorStore(kernel(sampleX, sampleY, sampleZ, hashSeed), rowValues + x);
+		}
+		if(x < endX)
+		{
+			float lanes[4];
+			const VectorRegister sampleX = VectorAdd(VectorSetFloat1(origin.X + sampleSpacing.X * x), laneOffsets);
+			VectorStore(kernel(sampleX, sampleY, sampleZ, hashSeed), lanes);
+			FMemory::Memcpy(rowValues + x, lanes, (endX - x) * sizeof(float));
+		}
+	};
+
+	// Small grids aren't worth the task overhead
+	const int32 MinParallelSamples = 16384;
+	if(allowParallel && numSamples >= MinParallelSamples && numRuns > 1)
+	{
+		ParallelFor(numRuns, fillRun);
+	}
+	else
+	{
+		for(int32 runIndex = 0; runIndex < numRuns; ++runIndex)
+		{
+			fillRun(runIndex);
+		}
+	}
+}
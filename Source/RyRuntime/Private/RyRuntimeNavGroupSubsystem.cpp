@@ -0,0 +1,244 @@
+// Copyright 2020-2021 Sheffer Online Services.
+// MIT License. See LICENSE for details.
+
+#include "RyRuntimeNavGroupSubsystem.h"
+#include "RyRuntimeModule.h"
+#include "RyRuntimeNavigationHelpers.h"
+#include "RyRuntimeNavUpdateSubsystem.h"
+#include "EngineUtils.h"
+#include "NavModifierComponent.h"
+#include "NavLinkCustomComponent.h"
+#include "NavAreas/NavArea.h"
+#include "Navigation/NavLinkProxy.h"
+
+DECLARE_CYCLE_STAT(TEXT("NavGroup Update"), STAT_RyNavGroupUpdate, STATGROUP_RyRuntime);
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeNavGroupSubsystem::FNavGroup::RemoveStale()
+{
+    NavLinks.RemoveAllSwap([](const TWeakObjectPtr<ANavLinkProxy>& navLink) { return !navLink.IsValid(); }, false);
+    NavModifiers.RemoveAllSwap([](const TWeakObjectPtr<UNavModifierComponent>& navModifier) { return !navModifier.IsValid(); }, false);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeNavGroupSubsystem::Deinitialize()
+{
+    Groups.Reset();
+    Super::Deinitialize();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+bool URyRuntimeNavGroupSubsystem::AddNavLinkToGroup(const FName groupName, ANavLinkProxy* navLinkProxy)
+{
+    if(!navLinkProxy)
+    {
+        UE_LOG(LogRyRuntime, Warning, TEXT("AddNavLinkToGroup: Invalid navLinkProxy"));
+        return false;
+    }
+
+    FNavGroup& group = Groups.FindOrAdd(groupName);
+    if(group.NavLinks.Contains(navLinkProxy))
+    {
+        return false;
+    }
+    group.NavLinks.Add(navLinkProxy);
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+bool URyRuntimeNavGroupSubsystem::AddNavModifierToGroup(const FName groupName, UNavModifierComponent* navModifier)
+{
+    if(!navModifier)
+    {
+        UE_LOG(LogRyRuntime, Warning, TEXT("AddNavModifierToGroup: Invalid navModifier"));
+        return false;
+    }
+
+    FNavGroup& group = Groups.FindOrAdd(groupName);
+    if(group.NavModifiers.Contains(navModifier))
+    {
+        return false;
+    }
+    group.NavModifiers.Add(navModifier);
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+int32 URyRuntimeNavGroupSubsystem::AddActorsWithTagToNavGroup(const FName groupName, const FName actorTag)
+{
+    UWorld* world = GetWorld();
+    if(!world || actorTag.IsNone())
+    {
+        return 0;
+    }
+
+    int32 numAdded = 0;
+    for(TActorIterator<AActor> it(world); it; ++it)
+    {
+        AActor* actor = *it;
+        if(!actor->ActorHasTag(actorTag))
+        {
+            continue;
+        }
+
+        if(ANavLinkProxy* navLinkProxy = Cast<ANavLinkProxy>(actor))
+        {
+            numAdded += AddNavLinkToGroup(groupName, navLinkProxy) ? 1 : 0;
+        }
+
+        TInlineComponentArray<UNavModifierComponent*> navModifiers(actor);
+        for(UNavModifierComponent* navModifier : navModifiers)
+        {
+            numAdded += AddNavModifierToGroup(groupName, navModifier) ? 1 : 0;
+        }
+    }
+    return numAdded;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+bool URyRuntimeNavGroupSubsystem::RemoveFromNavGroup(const FName groupName, UObject* member)
+{
+    FNavGroup* group = Groups.Find(groupName);
+    if(!group || !member)
+    {
+        return false;
+    }
+
+    if(ANavLinkProxy* navLinkProxy = Cast<ANavLinkProxy>(member))
+    {
+        return group->NavLinks.RemoveSingleSwap(navLinkProxy, false) > 0;
+    }
+    if(UNavModifierComponent* navModifier = Cast<UNavModifierComponent>(member))
+    {
+        return group->NavModifiers.RemoveSingleSwap(navModifier, false) > 0;
+    }
+    return false;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeNavGroupSubsystem::RemoveNavGroup(const FName groupName)
+{
+    Groups.Remove(groupName);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+int32 URyRuntimeNavGroupSubsystem::SetNavGroupEnabled(const FName groupName, const bool enabled)
+{
+    SCOPE_CYCLE_COUNTER(STAT_RyNavGroupUpdate);
+
+    FNavGroup* group = Groups.Find(groupName);
+    if(!group)
+    {
+        UE_LOG(LogRyRuntime, Warning, TEXT("SetNavGroupEnabled: No nav group named %s"), *groupName.ToString());
+        return 0;
+    }
+    group->RemoveStale();
+
+    // One octree update per proxy, issued when the batch ends. Smart link and modifier components update themselves.
+    FRyScopedNavOctreeUpdateBatch navUpdateBatch(GetWorld());
+
+    int32 numChanged = 0;
+    for(const TWeakObjectPtr<ANavLinkProxy>& navLink : group->NavLinks)
+    {
+        ANavLinkProxy* navLinkProxy = navLink.Get();
+        if(navLinkProxy->GetSmartLinkComp() && navLinkProxy->bSmartLinkIsRelevant != enabled)
+        {
+            URyRuntimeNavigationHelpers::SetSmartLinkIsRelevant(navLinkProxy, enabled);
+            ++numChanged;
+        }
+    }
+
+    for(const TWeakObjectPtr<UNavModifierComponent>& navModifierPtr : group->NavModifiers)
+    {
+        // Relevancy, as SetSmartLinkIsRelevant does for the link component, rather than the persistent CanEverAffectNavigation.
+        // This updates the modifier in the nav octree straight away.
+        UNavModifierComponent* navModifier = navModifierPtr.Get();
+        if(navModifier->IsNavigationRelevant() != enabled)
+        {
+            navModifier->SetNavigationRelevancy(enabled);
+            ++numChanged;
+        }
+    }
+    return numChanged;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+int32 URyRuntimeNavGroupSubsystem::SetNavGroupAreaClass(const FName groupName, TSubclassOf<UNavArea> areaClass)
+{
+    SCOPE_CYCLE_COUNTER(STAT_RyNavGroupUpdate);
+
+    FNavGroup* group = Groups.Find(groupName);
+    if(!group)
+    {
+        UE_LOG(LogRyRuntime, Warning, TEXT("SetNavGroupAreaClass: No nav group named %s"), *groupName.ToString());
+        return 0;
+    }
+    group->RemoveStale();
+
+    // Areas are pushed straight to the custom links and modifiers, each of which updates the navigation system itself
+    int32 numChanged = 0;
+    for(const TWeakObjectPtr<ANavLinkProxy>& navLink : group->NavLinks)
+    {
+        UNavLinkCustomComponent* smartLink = navLink->GetSmartLinkComp();
+        if(smartLink && smartLink->GetEnabledArea() != areaClass)
+        {
+            smartLink->SetEnabledArea(areaClass);
+            ++numChanged;
+        }
+    }
+
+    for(const TWeakObjectPtr<UNavModifierComponent>& navModifier : group->NavModifiers)
+    {
+        if(navModifier->AreaClass != areaClass)
+        {
+            navModifier->SetAreaClass(areaClass);
+            ++numChanged;
+        }
+    }
+    return numChanged;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeNavGroupSubsystem::GetNavGroupMembers(const FName groupName, TArray<ANavLinkProxy*>& navLinksOut,
+                                                     TArray<UNavModifierComponent*>& navModifiersOut) const
+{
+    navLinksOut.Reset();
+    navModifiersOut.Reset();
+    if(const FNavGroup* group = Groups.Find(groupName))
+    {
+        for(const TWeakObjectPtr<ANavLinkProxy>& navLink : group->NavLinks)
+        {
+            if(ANavLinkProxy* navLinkProxy = navLink.Get())
+            {
+                navLinksOut.Add(navLinkProxy);
+            }
+        }
+        for(const TWeakObjectPtr<UNavModifierComponent>& navModifier : group->NavModifiers)
+        {
+            if(UNavModifierComponent* liveNavModifier = navModifier.Get())
+            {
+                navModifiersOut.Add(liveNavModifier);
+            }
+        }
+    }
+}
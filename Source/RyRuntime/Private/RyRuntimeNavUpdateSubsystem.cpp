@@ -0,0 +1,211 @@
+// Copyright 2020-2021 Sheffer Online Services.
+// MIT License. See LICENSE for details.
+
+#include "RyRuntimeNavUpdateSubsystem.h"
+#include "RyRuntimeModule.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "NavigationSystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("NavUpdate Flush"), STAT_RyNavUpdateFlush, STATGROUP_RyRuntime);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("NavUpdate Octree Updates Issued"), STAT_RyNavUpdateIssued, STATGROUP_RyRuntime);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("NavUpdate Requests Coalesced"), STAT_RyNavUpdateCoalesced, STATGROUP_RyRuntime);
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeNavUpdateSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+    PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &URyRuntimeNavUpdateSubsystem::OnWorldPostActorTick);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeNavUpdateSubsystem::Deinitialize()
+{
+    FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+    PendingActors.Reset();
+    PendingActorSet.Reset();
+    Super::Deinitialize();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeNavUpdateSubsystem::RequestNavOctreeUpdate(AActor* actor)
+{
+    if(!actor)
+    {
+        return;
+    }
+
+    UWorld* world = actor->GetWorld();
+    URyRuntimeNavUpdateSubsystem* subsystem = world ? world->GetSubsystem<URyRuntimeNavUpdateSubsystem>() : nullptr;
+    if(subsystem)
+    {
+        subsystem->RequestActorUpdate(actor);
+    }
+    else
+    {
+        IssueUpdate(*actor);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeNavUpdateSubsystem::RequestActorUpdate(AActor* actor)
+{
+    if(!actor)
+    {
+        return;
+    }
+
+    ++Stats.NumRequested;
+    if(!ShouldDefer())
+    {
+        ++Stats.NumIssued;
+        INC_DWORD_STAT(STAT_RyNavUpdateIssued);
+        IssueUpdate(*actor);
+        return;
+    }
+
+    bool alreadyPending = false;
+    PendingActorSet.Add(actor, &alreadyPending);
+    if(alreadyPending)
+    {
+        ++Stats.NumCoalesced;
+        INC_DWORD_STAT(STAT_RyNavUpdateCoalesced);
+    }
+    else
+    {
+        PendingActors.Add(actor);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeNavUpdateSubsystem::FlushNavOctreeUpdates()
+{
+    if(PendingActors.Num() == 0)
+    {
+        return;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_RyNavUpdateFlush);
+
+    // Swap out first, an update may lead to more requests
+    TArray<TWeakObjectPtr<AActor>> actors = MoveTemp(PendingActors);
+    PendingActors.Reset();
+    PendingActorSet.Reset();
+
+    int32 numIssued = 0;
+    for(const TWeakObjectPtr<AActor>& actor : actors)
+    {
+        if(AActor* liveActor = actor.Get())
+        {
+            IssueUpdate(*liveActor);
+            ++numIssued;
+        }
+    }
+
+    if(numIssued > 0)
+    {
+        Stats.NumIssued += numIssued;
+        ++Stats.NumFlushes;
+        INC_DWORD_STAT_BY(STAT_RyNavUpdateIssued, numIssued);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeNavUpdateSubsystem::EndNavOctreeUpdateBatch()
+{
+    if(BatchDepth <= 0)
+    {
+        UE_LOG(LogRyRuntime, Warning, TEXT("EndNavOctreeUpdateBatch: No batch is open"));
+        return;
+    }
+
+    if(--BatchDepth == 0)
+    {
+        FlushNavOctreeUpdates();
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeNavUpdateSubsystem::SetDeferToEndOfFrame(const bool deferToEndOfFrame)
+{
+    DeferToEndOfFrame = deferToEndOfFrame;
+    if(!ShouldDefer())
+    {
+        FlushNavOctreeUpdates();
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+bool URyRuntimeNavUpdateSubsystem::ShouldDefer() const
+{
+    if(BatchDepth > 0)
+    {
+        return true;
+    }
+
+    // Only game worlds are sure to tick, so only they can wait for the end of the frame
+    const UWorld* world = GetWorld();
+    return DeferToEndOfFrame && world && world->IsGameWorld();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeNavUpdateSubsystem::IssueUpdate(AActor& actor)
+{
+    if(UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(actor.GetWorld()))
+    {
+        NavSys->UpdateActorInNavOctree(actor);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeNavUpdateSubsystem::OnWorldPostActorTick(UWorld* world, ELevelTick tickType, float deltaSeconds)
+{
+    // Batches span frames at the caller's request, leave them to flush when they end
+    if(world == GetWorld() && BatchDepth == 0)
+    {
+        FlushNavOctreeUpdates();
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+FRyScopedNavOctreeUpdateBatch::FRyScopedNavOctreeUpdateBatch(UWorld* world)
+{
+    if(URyRuntimeNavUpdateSubsystem* subsystem = world ? world->GetSubsystem<URyRuntimeNavUpdateSubsystem>() : nullptr)
+    {
+        subsystem->BeginNavOctreeUpdateBatch();
+        Subsystem = subsystem;
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+FRyScopedNavOctreeUpdateBatch::~FRyScopedNavOctreeUpdateBatch()
+{
+    if(URyRuntimeNavUpdateSubsystem* subsystem = Subsystem.Get())
+    {
+        subsystem->EndNavOctreeUpdateBatch();
+    }
+}
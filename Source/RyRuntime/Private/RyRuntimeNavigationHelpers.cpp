@@ -2,6 +2,7 @@
 // MIT License. See LICENSE for details.
 
 #include "RyRuntimeNavigationHelpers.h"
+#include "RyRuntimeNavUpdateSubsystem.h"
 #include "Kismet/GameplayStatics.h"
 
 #include "NavigationSystem.h"
@@ -70,12 +71,7 @@ void URyRuntimeNavigationHelpers::SetSmartLinkData(ANavLinkProxy* navLinkProxy,
     }
 
     navLinkProxy->GetSmartLinkComp()->SetLinkData(relativeStart, relativeEnd, static_cast<ENavLinkDirection::Type>(direction));
-
-    UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(navLinkProxy->GetWorld());
-    if (NavSys)
-    {
-        NavSys->UpdateActorInNavOctree(*navLinkProxy);
-    }
+    URyRuntimeNavUpdateSubsystem::RequestNavOctreeUpdate(navLinkProxy);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -86,13 +82,34 @@ void URyRuntimeNavigationHelpers::SetSmartLinkIsRelevant(ANavLinkProxy* navLinkP
     if(navLinkProxy)
     {
         navLinkProxy->bSmartLinkIsRelevant = isRelevant;
+        // Updates the component in the nav octree straight away, only the proxy update below is batched
         navLinkProxy->GetSmartLinkComp()->SetNavigationRelevancy(isRelevant);
+        URyRuntimeNavUpdateSubsystem::RequestNavOctreeUpdate(navLinkProxy);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeNavigationHelpers::SetSmartLinksAreRelevant(const TArray<ANavLinkProxy*>& navLinkProxies, const bool isRelevant)
+{
+    // Proxies are usually all in one world, batch updates in each world met
+    TArray<FRyScopedNavOctreeUpdateBatch, TInlineAllocator<2>> navUpdateBatches;
+    TArray<UWorld*, TInlineAllocator<2>> batchedWorlds;
+    for(ANavLinkProxy* navLinkProxy : navLinkProxies)
+    {
+        if(!navLinkProxy || !navLinkProxy->GetSmartLinkComp())
+        {
+            continue;
+        }
 
-        UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(navLinkProxy->GetWorld());
-        if (NavSys)
+        UWorld* world = navLinkProxy->GetWorld();
+        if(!batchedWorlds.Contains(world))
         {
-            NavSys->UpdateActorInNavOctree(*navLinkProxy);
+            batchedWorlds.Add(world);
+            navUpdateBatches.Emplace(world);
         }
+        SetSmartLinkIsRelevant(navLinkProxy, isRelevant);
     }
 }
 
@@ -0,0 +1,339 @@
+// Copyright 2020-2021 Sheffer Online Services.
+// MIT License. See LICENSE for details.
+
+#include "RyRuntimeRotationInterpolatorSubsystem.h"
+#include "RyRuntimeModule.h"
+#include "RyRuntimeMathHelpers.h"
+#include "Components/SceneComponent.h"
+
+DECLARE_CYCLE_STAT(TEXT("RotationInterpolator Update"), STAT_RyRotationInterpolatorUpdate, STATGROUP_RyRuntime);
+DECLARE_DWORD_COUNTER_STAT(TEXT("RotationInterpolator Num Interpolators"), STAT_RyRotationInterpolatorNum, STATGROUP_RyRuntime);
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+static float GetRotationAxis(const FRotator& rotation, const ERyRotationAxis axis)
+{
+    switch(axis)
+    {
+        case ERyRotationAxis::Pitch: return rotation.Pitch;
+        case ERyRotationAxis::Yaw: return rotation.Yaw;
+        default: return rotation.Roll;
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeRotationInterpolatorSubsystem::Deinitialize()
+{
+    UnregisterAllInterpolators();
+    Super::Deinitialize();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeRotationInterpolatorSubsystem::Tick(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_RyRotationInterpolatorUpdate);
+
+    const int32 num = Currents.Num();
+    SET_DWORD_STAT(STAT_RyRotationInterpolatorNum, num);
+
+    // Remember who was already at target so outputs are only written while moving, and arrival fires once
+    PreviousAtTargets = AtTargets;
+    URyRuntimeMathHelpers::RotationInterpolateBatch(Currents.GetData(), Targets.GetData(), Speeds.GetData(), DeltaTime, CheckTolerance,
+                                                    Currents.GetData(), AtTargets.GetData(), num);
+
+    for(int32 index = 0; index < num; ++index)
+    {
+        if(PreviousAtTargets[index])
+        {
+            continue;
+        }
+
+        const FOutput& output = Outputs[index];
+        if(output.OnUpdated.IsBound())
+        {
+            PendingCallbacks.Emplace(output.Handle, Currents[index]);
+        }
+        else if(output.Component.IsValid())
+        {
+            PendingWrites.Add({output.Component, output.Axis, output.WorldSpace, Currents[index]});
+        }
+        else
+        {
+            DeadHandles.Add(output.Handle);
+            continue;
+        }
+
+        if(AtTargets[index])
+        {
+            PendingArrivals.Emplace(output.Handle, Currents[index]);
+        }
+    }
+
+    for(const int32 deadHandle : DeadHandles)
+    {
+        UnregisterInterpolator(deadHandle);
+    }
+    DeadHandles.Reset();
+
+    // User code runs last, as it may register or unregister interpolators. Component writes count, as moving a component
+    // updates overlaps and so can run overlap events.
+    for(const FPendingWrite& pendingWrite : PendingWrites)
+    {
+        WriteOutput(pendingWrite);
+    }
+    PendingWrites.Reset();
+
+    for(const TPair<int32, float>& pendingCallback : PendingCallbacks)
+    {
+        if(const int32* index = HandleToIndex.Find(pendingCallback.Key))
+        {
+            Outputs[*index].OnUpdated.ExecuteIfBound(pendingCallback.Key, pendingCallback.Value);
+        }
+    }
+    PendingCallbacks.Reset();
+
+    for(const TPair<int32, float>& pendingArrival : PendingArrivals)
+    {
+        OnInterpolatorAtTarget.Broadcast(pendingArrival.Key, pendingArrival.Value);
+    }
+    PendingArrivals.Reset();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+ETickableTickType URyRuntimeRotationInterpolatorSubsystem::GetTickableTickType() const
+{
+    return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+bool URyRuntimeRotationInterpolatorSubsystem::IsTickable() const
+{
+    return Currents.Num() != 0;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+TStatId URyRuntimeRotationInterpolatorSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(URyRuntimeRotationInterpolatorSubsystem, STATGROUP_RyRuntime);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+int32 URyRuntimeRotationInterpolatorSubsystem::RegisterComponentInterpolator(USceneComponent* component, const ERyRotationAxis axis,
+                                                                            const float target, const float speed, const bool worldSpace)
+{
+    if(!component)
+    {
+        UE_LOG(LogRyRuntime, Warning, TEXT("RegisterComponentInterpolator: Invalid component"));
+        return INDEX_NONE;
+    }
+
+    FOutput output;
+    output.Component = component;
+    output.Axis = axis;
+    output.WorldSpace = worldSpace;
+    const FRotator rotation = worldSpace ? component->GetComponentRotation() : component->GetRelativeRotation();
+    return AddInterpolator(GetRotationAxis(rotation, axis), target, speed, MoveTemp(output));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+int32 URyRuntimeRotationInterpolatorSubsystem::RegisterCallbackInterpolator(const float current, const float target, const float speed,
+                                                                           FRyOnRotationUpdated onUpdated)
+{
+    if(!onUpdated.IsBound())
+    {
+        UE_LOG(LogRyRuntime, Warning, TEXT("RegisterCallbackInterpolator: onUpdated isn't bound"));
+        return INDEX_NONE;
+    }
+
+    FOutput output;
+    output.Axis = ERyRotationAxis::Yaw;
+    output.WorldSpace = false;
+    output.OnUpdated = onUpdated;
+    return AddInterpolator(current, target, speed, MoveTemp(output));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+bool URyRuntimeRotationInterpolatorSubsystem::UnregisterInterpolator(const int32 interpolatorHandle)
+{
+    int32 index;
+    if(!HandleToIndex.RemoveAndCopyValue(interpolatorHandle, index))
+    {
+        return false;
+    }
+
+    RemoveInterpolatorAt(index);
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeRotationInterpolatorSubsystem::UnregisterAllInterpolators()
+{
+    Currents.Reset();
+    Targets.Reset();
+    Speeds.Reset();
+    AtTargets.Reset();
+    Outputs.Reset();
+    HandleToIndex.Reset();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+bool URyRuntimeRotationInterpolatorSubsystem::SetInterpolatorTarget(const int32 interpolatorHandle, const float target)
+{
+    const int32* index = HandleToIndex.Find(interpolatorHandle);
+    if(!index)
+    {
+        return false;
+    }
+
+    Targets[*index] = target;
+    AtTargets[*index] = false;
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+bool URyRuntimeRotationInterpolatorSubsystem::SetInterpolatorSpeed(const int32 interpolatorHandle, const float speed)
+{
+    const int32* index = HandleToIndex.Find(interpolatorHandle);
+    if(!index)
+    {
+        return false;
+    }
+
+    Speeds[*index] = speed;
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+bool URyRuntimeRotationInterpolatorSubsystem::SetInterpolatorCurrent(const int32 interpolatorHandle, const float current)
+{
+    const int32* index = HandleToIndex.Find(interpolatorHandle);
+    if(!index)
+    {
+        return false;
+    }
+
+    Currents[*index] = current;
+    AtTargets[*index] = false;
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+bool URyRuntimeRotationInterpolatorSubsystem::GetInterpolatorCurrent(const int32 interpolatorHandle, float& current) const
+{
+    const int32* index = HandleToIndex.Find(interpolatorHandle);
+    if(!index)
+    {
+        current = 0.0f;
+        return false;
+    }
+
+    current = Currents[*index];
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+bool URyRuntimeRotationInterpolatorSubsystem::IsInterpolatorAtTarget(const int32 interpolatorHandle) const
+{
+    const int32* index = HandleToIndex.Find(interpolatorHandle);
+    return index && AtTargets[*index];
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+int32 URyRuntimeRotationInterpolatorSubsystem::AddInterpolator(const float current, const float target, const float speed, FOutput&& output)
+{
+    // Skip any handle still in use after wrapping around
+    do
+    {
+        NextHandle = NextHandle == MAX_int32 ? 0 : NextHandle + 1;
+    }
+    while(HandleToIndex.Contains(NextHandle));
+
+    output.Handle = NextHandle;
+    HandleToIndex.Add(NextHandle, Currents.Num());
+    Currents.Add(current);
+    Targets.Add(target);
+    Speeds.Add(speed);
+    AtTargets.Add(false);
+    Outputs.Add(MoveTemp(output));
+    return NextHandle;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeRotationInterpolatorSubsystem::RemoveInterpolatorAt(const int32 index)
+{
+    // Swap the last interpolator into the hole and re-point its handle
+    const int32 lastIndex = Currents.Num() - 1;
+    if(index != lastIndex)
+    {
+        HandleToIndex.Add(Outputs[lastIndex].Handle, index);
+    }
+
+    Currents.RemoveAtSwap(index, 1, false);
+    Targets.RemoveAtSwap(index, 1, false);
+    Speeds.RemoveAtSwap(index, 1, false);
+    AtTargets.RemoveAtSwap(index, 1, false);
+    Outputs.RemoveAtSwap(index, 1, false);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeRotationInterpolatorSubsystem::WriteOutput(const FPendingWrite& pendingWrite)
+{
+    // An earlier write's overlap events may have destroyed the component
+    USceneComponent* component = pendingWrite.Component.Get();
+    if(!component)
+    {
+        return;
+    }
+
+    FRotator newRotation = pendingWrite.WorldSpace ? component->GetComponentRotation() : component->GetRelativeRotation();
+    switch(pendingWrite.Axis)
+    {
+        case ERyRotationAxis::Pitch: newRotation.Pitch = pendingWrite.Rotation; break;
+        case ERyRotationAxis::Yaw: newRotation.Yaw = pendingWrite.Rotation; break;
+        case ERyRotationAxis::Roll: newRotation.Roll = pendingWrite.Rotation; break;
+    }
+
+    if(pendingWrite.WorldSpace)
+    {
+        component->SetWorldRotation(newRotation);
+    }
+    else
+    {
+        component->SetRelativeRotation(newRotation);
+    }
+}
@@ -0,0 +1,407 @@
+// Copyright 2020-2021 Sheffer Online Services.
+// MIT License. See LICENSE for details.
+
+#include "RyRuntimeSpatialHashSubsystem.h"
+#include "RyRuntimeModule.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "Kismet/GameplayStatics.h"
+
+DECLARE_CYCLE_STAT(TEXT("SpatialHash Query"), STAT_RySpatialHashQuery, STATGROUP_RyRuntime);
+DECLARE_CYCLE_STAT(TEXT("SpatialHash Update"), STAT_RySpatialHashUpdate, STATGROUP_RyRuntime);
+DECLARE_DWORD_COUNTER_STAT(TEXT("SpatialHash Queries"), STAT_RySpatialHashNumQueries, STATGROUP_RyRuntime);
+DECLARE_DWORD_COUNTER_STAT(TEXT("SpatialHash Cell Changes"), STAT_RySpatialHashNumCellChanges, STATGROUP_RyRuntime);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("SpatialHash Registered Actors"), STAT_RySpatialHashNumActors, STATGROUP_RyRuntime);
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeSpatialHashSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeSpatialHashSubsystem::Deinitialize()
+{
+    UnregisterAllActors();
+    Super::Deinitialize();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeSpatialHashSubsystem::SetCellSize(const float newCellSize)
+{
+    if(newCellSize <= KINDA_SMALL_NUMBER)
+    {
+        UE_LOG(LogRyRuntime, Warning, TEXT("URyRuntimeSpatialHashSubsystem::SetCellSize called with invalid cell size %f!"), newCellSize);
+        return;
+    }
+
+    CellSize = newCellSize;
+    InvCellSize = 1.0f / newCellSize;
+
+    // Re-hash everything into the new cells
+    TMap<FIntVector, TArray<FCellItem>> oldCells = MoveTemp(Cells);
+    Cells.Reset();
+    for(const TPair<FIntVector, TArray<FCellItem>>& cellPair : oldCells)
+    {
+        for(const FCellItem& item : cellPair.Value)
+        {
+            AActor* actor = item.Actor.Get();
+            FEntry* entry = actor ? Entries.Find(actor) : nullptr;
+            if(entry)
+            {
+                entry->Cell = GetCell(item.Location);
+                AddToCell(actor, entry->Cell, item.Location);
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+bool URyRuntimeSpatialHashSubsystem::RegisterActor(AActor* actor)
+{
+    if(!actor || actor->IsPendingKill())
+    {
+        return false;
+    }
+
+    USceneComponent* rootComponent = actor->GetRootComponent();
+    if(!rootComponent)
+    {
+        UE_LOG(LogRyRuntime, Warning, TEXT("URyRuntimeSpatialHashSubsystem::RegisterActor called with actor %s that has no root component!"), *actor->GetName());
+        return false;
+    }
+
+    if(Entries.Contains(actor))
+    {
+        return false;
+    }
+
+    const FVector location = rootComponent->GetComponentLocation();
+
+    FEntry& entry = Entries.Add(actor);
+    entry.Cell = GetCell(location);
+    entry.RootComponent = rootComponent;
+    entry.TransformUpdatedHandle = rootComponent->TransformUpdated.AddUObject(this, &URyRuntimeSpatialHashSubsystem::OnRootComponentTransformUpdated);
+    // EndPlay rather than OnDestroyed, as it is also called for actors in levels being streamed out
+    actor->OnEndPlay.AddUniqueDynamic(this, &URyRuntimeSpatialHashSubsystem::OnRegisteredActorEndPlay);
+
+    AddToCell(actor, entry.Cell, location);
+    INC_DWORD_STAT(STAT_RySpatialHashNumActors);
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+int32 URyRuntimeSpatialHashSubsystem::RegisterActorsOfClass(TSubclassOf<AActor> actorClass)
+{
+    UWorld* world = GetWorld();
+    if(!world || !actorClass)
+    {
+        return 0;
+    }
+
+    int32 numRegistered = 0;
+    for(TActorIterator<AActor> actorIt(world, actorClass); actorIt; ++actorIt)
+    {
+        if(RegisterActor(*actorIt))
+        {
+            ++numRegistered;
+        }
+    }
+    return numRegistered;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+bool URyRuntimeSpatialHashSubsystem::UnregisterActor(AActor* actor)
+{
+    FEntry entry;
+    if(!actor || !Entries.RemoveAndCopyValue(actor, entry))
+    {
+        return false;
+    }
+
+    if(USceneComponent* rootComponent = entry.RootComponent.Get())
+    {
+        rootComponent->TransformUpdated.Remove(entry.TransformUpdatedHandle);
+    }
+    actor->OnEndPlay.RemoveDynamic(this, &URyRuntimeSpatialHashSubsystem::OnRegisteredActorEndPlay);
+
+    RemoveFromCell(actor, entry.Cell);
+    DEC_DWORD_STAT(STAT_RySpatialHashNumActors);
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeSpatialHashSubsystem::UnregisterAllActors()
+{
+    for(const TPair<TWeakObjectPtr<AActor>, FEntry>& entryPair : Entries)
+    {
+        if(USceneComponent* rootComponent = entryPair.Value.RootComponent.Get())
+        {
+            rootComponent->TransformUpdated.Remove(entryPair.Value.TransformUpdatedHandle);
+        }
+        if(AActor* actor = entryPair.Key.Get())
+        {
+            actor->OnEndPlay.RemoveDynamic(this, &URyRuntimeSpatialHashSubsystem::OnRegisteredActorEndPlay);
+        }
+    }
+
+    DEC_DWORD_STAT_BY(STAT_RySpatialHashNumActors, Entries.Num());
+    Entries.Reset();
+    Cells.Reset();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+bool URyRuntimeSpatialHashSubsystem::IsActorRegistered(const AActor* actor) const
+{
+    return actor && Entries.Contains(const_cast<AActor*>(actor));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeSpatialHashSubsystem::QueryActorsInRadius(const FVector& location, const float radius, TSubclassOf<AActor> actorClass, TArray<AActor*>& actorsOut) const
+{
+    SCOPE_CYCLE_COUNTER(STAT_RySpatialHashQuery);
+    INC_DWORD_STAT(STAT_RySpatialHashNumQueries);
+
+    const float radiusSquared = FMath::Square(radius);
+    GatherInBounds(FBox::BuildAABB(location, FVector(radius)), actorClass, [&location, radiusSquared](const FVector& itemLocation)
+    {
+        return FVector::DistSquared(location, itemLocation) <= radiusSquared;
+    }, actorsOut);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeSpatialHashSubsystem::QueryActorsInBox(const FBox& box, TSubclassOf<AActor> actorClass, TArray<AActor*>& actorsOut) const
+{
+    SCOPE_CYCLE_COUNTER(STAT_RySpatialHashQuery);
+    INC_DWORD_STAT(STAT_RySpatialHashNumQueries);
+
+    GatherInBounds(box, actorClass, [&box](const FVector& itemLocation)
+    {
+        return box.IsInsideOrOn(itemLocation);
+    }, actorsOut);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeSpatialHashSubsystem::BenchmarkRadiusQuery(const FVector& location, const float radius, TSubclassOf<AActor> actorClass,
+                                                          float& hashMilliseconds, float& naiveMilliseconds, const int32 iterations) const
+{
+    hashMilliseconds = 0.0f;
+    naiveMilliseconds = 0.0f;
+
+    UWorld* world = GetWorld();
+    if(!world || iterations <= 0)
+    {
+        return;
+    }
+
+    TSubclassOf<AActor> naiveClass = actorClass ? actorClass : TSubclassOf<AActor>(AActor::StaticClass());
+    TArray<AActor*> results;
+
+    double startTime = FPlatformTime::Seconds();
+    for(int32 iteration = 0; iteration < iterations; ++iteration)
+    {
+        results.Reset();
+        QueryActorsInRadius(location, radius, actorClass, results);
+    }
+    hashMilliseconds = static_cast<float>((FPlatformTime::Seconds() - startTime) * 1000.0 / iterations);
+
+    const float radiusSquared = FMath::Square(radius);
+    TArray<AActor*> allActors;
+    startTime = FPlatformTime::Seconds();
+    for(int32 iteration = 0; iteration < iterations; ++iteration)
+    {
+        results.Reset();
+        allActors.Reset();
+        UGameplayStatics::GetAllActorsOfClass(world, naiveClass, allActors);
+        for(AActor* actor : allActors)
+        {
+            if(FVector::DistSquared(actor->GetActorLocation(), location) <= radiusSquared)
+            {
+                results.Add(actor);
+            }
+        }
+    }
+    naiveMilliseconds = static_cast<float>((FPlatformTime::Seconds() - startTime) * 1000.0 / iterations);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+FIntVector URyRuntimeSpatialHashSubsystem::GetCell(const FVector& location) const
+{
+    return FIntVector(FMath::FloorToInt(location.X * InvCellSize),
+                      FMath::FloorToInt(location.Y * InvCellSize),
+                      FMath::FloorToInt(location.Z * InvCellSize));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeSpatialHashSubsystem::AddToCell(AActor* actor, const FIntVector& cell, const FVector& location)
+{
+    FCellItem& item = Cells.FindOrAdd(cell).AddDefaulted_GetRef();
+    item.Actor = actor;
+    item.Location = location;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeSpatialHashSubsystem::RemoveFromCell(const AActor* actor, const FIntVector& cell)
+{
+    TArray<FCellItem>* items = Cells.Find(cell);
+    if(!items)
+    {
+        return;
+    }
+
+    const int32 itemIndex = items->IndexOfByPredicate([actor](const FCellItem& item) { return item.Actor.Get() == actor; });
+    if(itemIndex != INDEX_NONE)
+    {
+        items->RemoveAtSwap(itemIndex, 1, false);
+    }
+    if(items->Num() == 0)
+    {
+        Cells.Remove(cell);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeSpatialHashSubsystem::UpdateActor(AActor* actor, const FVector& location)
+{
+    SCOPE_CYCLE_COUNTER(STAT_RySpatialHashUpdate);
+
+    FEntry* entry = Entries.Find(actor);
+    if(!entry)
+    {
+        return;
+    }
+
+    const FIntVector newCell = GetCell(location);
+    if(newCell == entry->Cell)
+    {
+        // Same cell, just refresh the cached location
+        if(TArray<FCellItem>* items = Cells.Find(newCell))
+        {
+            for(FCellItem& item : *items)
+            {
+                if(item.Actor.Get() == actor)
+                {
+                    item.Location = location;
+                    break;
+                }
+            }
+        }
+        return;
+    }
+
+    INC_DWORD_STAT(STAT_RySpatialHashNumCellChanges);
+    RemoveFromCell(actor, entry->Cell);
+    entry->Cell = newCell;
+    AddToCell(actor, newCell, location);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeSpatialHashSubsystem::GatherInBounds(const FBox& bounds, TSubclassOf<AActor> actorClass,
+                                                    TFunctionRef<bool(const FVector&)> filter, TArray<AActor*>& actorsOut) const
+{
+    UClass* filterClass = actorClass.Get();
+    auto gatherItem = [filterClass, &filter, &actorsOut](const FCellItem& item)
+    {
+        // Actors can go away without EndPlay, e.g. destroyed in an editor world, skip any on their way out
+        AActor* actor = item.Actor.Get();
+        if(actor && !actor->IsPendingKillPending() && (!filterClass || actor->IsA(filterClass)) && filter(item.Location))
+        {
+            actorsOut.Add(actor);
+        }
+    };
+
+    const FIntVector minCell = GetCell(bounds.Min);
+    const FIntVector maxCell = GetCell(bounds.Max);
+    const int64 numQueryCells = static_cast<int64>(maxCell.X - minCell.X + 1) * (maxCell.Y - minCell.Y + 1) * (maxCell.Z - minCell.Z + 1);
+
+    if(numQueryCells > Cells.Num())
+    {
+        // The query covers more cells than are occupied, walking the occupied cells is cheaper
+        for(const TPair<FIntVector, TArray<FCellItem>>& cellPair : Cells)
+        {
+            const FIntVector& cell = cellPair.Key;
+            if(cell.X < minCell.X || cell.Y < minCell.Y || cell.Z < minCell.Z ||
+               cell.X > maxCell.X || cell.Y > maxCell.Y || cell.Z > maxCell.Z)
+            {
+                continue;
+            }
+
+            for(const FCellItem& item : cellPair.Value)
+            {
+                gatherItem(item);
+            }
+        }
+        return;
+    }
+
+    for(int32 cellZ = minCell.Z; cellZ <= maxCell.Z; ++cellZ)
+    {
+        for(int32 cellY = minCell.Y; cellY <= maxCell.Y; ++cellY)
+        {
+            for(int32 cellX = minCell.X; cellX <= maxCell.X; ++cellX)
+            {
+                const TArray<FCellItem>* items = Cells.Find(FIntVector(cellX, cellY, cellZ));
+                if(!items)
+                {
+                    continue;
+                }
+
+                for(const FCellItem& item : *items)
+                {
+                    gatherItem(item);
+                }
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeSpatialHashSubsystem::OnRootComponentTransformUpdated(USceneComponent* updatedComponent, EUpdateTransformFlags updateTransformFlags, ETeleportType teleport)
+{
+    if(updatedComponent)
+    {
+        UpdateActor(updatedComponent->GetOwner(), updatedComponent->GetComponentLocation());
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+void URyRuntimeSpatialHashSubsystem::OnRegisteredActorEndPlay(AActor* actor, EEndPlayReason::Type endPlayReason)
+{
+    UnregisterActor(actor);
+}
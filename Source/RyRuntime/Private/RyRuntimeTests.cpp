@@ -0,0 +1,889 @@
+// Copyright 2020-2021 Sheffer Online Services.
+// MIT License. See LICENSE for details.
+
+// Correctness tests for the RyRuntime batch helpers, registered as the Ry.Runtime automation tests.
+// Headless example (Linux), running these and the Ry.Benchmarks suite:
+//   UE4Editor-Cmd MyProject.uproject -unattended -nullrhi -nosplash -ExecCmds="Automation RunTests Ry;Quit"
+//
+// Each batch path is checked against the scalar function it replaces, or against a double precision or brute force
+// reference where there is no scalar version.
+
+#include "RyRuntimeModule.h"
+#include "RyRuntimeMathHelpers.h"
+#include "RyRuntimeComponentHelpers.h"
+#include "Components/SplineComponent.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace RyRuntimeTests
+{
+
+typedef URyRuntimeMathHelpers FMathHelpers;
+
+static constexpr int32 NumElements = 1027; // Not a multiple of 4, so the SIMD tails are covered too
+static constexpr uint32 TestFlags = EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter;
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * Fills values with numValues random floats in [min, max]
+*/
+static void MakeRandomFloats(FRandomStream& randomStream, const int32 numValues, const float min, const float max, TArray<float>& values)
+{
+    values.SetNumUninitialized(numValues);
+    for(float& value : values)
+    {
+        value = randomStream.FRandRange(min, max);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * Checks batch against expected element by element, within an absolute tolerance plus a tolerance relative to the
+ * expected value. Only the first mismatch is reported, with the largest error over the whole array.
+*/
+static bool TestArraysNearlyEqual(FAutomationTestBase& test, const TCHAR* what, const TArray<float>& batch, const TArray<float>& expected,
+                                  const double absoluteTolerance, const double relativeTolerance = 0.0)
+{
+    if(batch.Num() != expected.Num())
+    {
+        test.AddError(FString::Printf(TEXT("%s: %d results, expected %d"), what, batch.Num(), expected.Num()));
+        return false;
+    }
+
+    int32 firstMismatch = INDEX_NONE;
+    double maxError = 0.0;
+    for(int32 index = 0; index < batch.Num(); ++index)
+    {
+        const double error = FMath::Abs(static_cast<double>(batch[index]) - expected[index]);
+        maxError = FMath::Max(maxError, error);
+        if(firstMismatch == INDEX_NONE && !(error <= absoluteTolerance + relativeTolerance * FMath::Abs(expected[index])))
+        {
+            firstMismatch = index;
+        }
+    }
+
+    if(firstMismatch != INDEX_NONE)
+    {
+        test.AddError(FString::Printf(TEXT("%s: [%d] is %.9g, expected %.9g (max error %g)"), what, firstMismatch, batch[firstMismatch],
+                                      expected[firstMismatch], maxError));
+        return false;
+    }
+    return true;
+}
+
+} // namespace RyRuntimeTests
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRyRuntimeRotationArraysTest, "Ry.Runtime.Math.RotationArrays", RyRuntimeTests::TestFlags)
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * ShortestRotationPathArray and RotationInterpolateArray against their scalar versions
+*/
+bool FRyRuntimeRotationArraysTest::RunTest(const FString& Parameters)
+{
+    using namespace RyRuntimeTests;
+
+    FRandomStream randomStream(NumElements);
+    TArray<float> currents, targets, speeds;
+    MakeRandomFloats(randomStream, NumElements, -720.0f, 720.0f, currents);
+    MakeRandomFloats(randomStream, NumElements, -720.0f, 720.0f, targets);
+    MakeRandomFloats(randomStream, NumElements, 0.0f, 1800.0f, speeds);
+    // Some already at their target, and some reached within one step
+    const float deltaTime = 1.0f / 60.0f;
+    for(int32 index = 0; index < NumElements; index += 16)
+    {
+        targets[index] = currents[index] + 360.0f;
+        targets[index + 1] = currents[index + 1] + speeds[index + 1] * deltaTime * 0.5f;
+    }
+
+    TArray<float> paths, expectedPaths;
+    FMathHelpers::ShortestRotationPathArray(currents, targets, paths);
+    expectedPaths.SetNumUninitialized(NumElements);
+    for(int32 index = 0; index < NumElements; ++index)
+    {
+        expectedPaths[index] = FMathHelpers::ShortestRotationPath(currents[index], targets[index]);
+    }
+    TestArraysNearlyEqual(*this, TEXT("ShortestRotationPathArray"), paths, expectedPaths, 1.e-3);
+
+    TArray<float> newRotations, expectedRotations;
+    TArray<bool> atTargets;
+    FMathHelpers::RotationInterpolateArray(currents, targets, deltaTime, speeds, newRotations, atTargets);
+    expectedRotations.SetNumUninitialized(NumElements);
+    int32 numAtTargetMismatches = 0;
+    for(int32 index = 0; index < NumElements; ++index)
+    {
+        bool expectedAtTarget;
+        FMathHelpers::RotationInterpolate(currents[index], targets[index], deltaTime, speeds[index], expectedRotations[index], expectedAtTarget);
+
+        // Measure around the circle, 0 and 360 are the same rotation
+        newRotations[index] = expectedRotations[index] + FMathHelpers::ShortestRotationPath(expectedRotations[index], newRotations[index]);
+
+        // The step and the remaining path can round differently, so only a step landing exactly on the target may disagree
+        const float remaining = FMath::Abs(expectedPaths[index]) - speeds[index] * deltaTime;
+        if(atTargets[index] != expectedAtTarget && FMath::Abs(remaining) > 1.e-3f)
+        {
+            ++numAtTargetMismatches;
+        }
+    }
+    TestArraysNearlyEqual(*this, TEXT("RotationInterpolateArray"), newRotations, expectedRotations, 1.e-3);
+    TestEqual(TEXT("RotationInterpolateArray at target mismatches"), numAtTargetMismatches, 0);
+
+    return !HasAnyErrors();
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRyRuntimeConvertUnitArrayTest, "Ry.Runtime.Math.ConvertUnitArray", RyRuntimeTests::TestFlags)
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * ConvertUnitArray against ConvertUnit, for an offset (temperature) and a plain scaled conversion
+*/
+bool FRyRuntimeConvertUnitArrayTest::RunTest(const FString& Parameters)
+{
+    using namespace RyRuntimeTests;
+
+    FRandomStream randomStream(NumElements);
+    TArray<float> values, converted, expected;
+    MakeRandomFloats(randomStream, NumElements, -1000.0f, 1000.0f, values);
+
+    const ERyUnit conversions[][2] = {{ERyUnit::Celsius, ERyUnit::Farenheit}, {ERyUnit::Farenheit, ERyUnit::Celsius}, {ERyUnit::Meters, ERyUnit::Feet}};
+    for(const auto& conversion : conversions)
+    {
+        FMathHelpers::ConvertUnitArray(values, FMathHelpers::MakeUnitConversionPlan(conversion[0], conversion[1]), converted);
+        expected.SetNumUninitialized(NumElements);
+        for(int32 index = 0; index < NumElements; ++index)
+        {
+            expected[index] = FMathHelpers::ConvertUnit(values[index], conversion[0], conversion[1]);
+        }
+        TestArraysNearlyEqual(*this, TEXT("ConvertUnitArray"), converted, expected, 1.e-4, 1.e-6);
+    }
+
+    return !HasAnyErrors();
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRyRuntimeVectorArrays2DTest, "Ry.Runtime.Math.VectorArrays2D", RyRuntimeTests::TestFlags)
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * Dot_VectorArray2D, DistanceSquared_VectorArray2D, FindNearestPoint2D and GetForwardVectors2D against their scalar
+ * versions or a brute force search
+*/
+bool FRyRuntimeVectorArrays2DTest::RunTest(const FString& Parameters)
+{
+    using namespace RyRuntimeTests;
+
+    FRandomStream randomStream(NumElements);
+    TArray<FVector> points;
+    TArray<FRotator> rotators;
+    points.SetNumUninitialized(NumElements);
+    rotators.SetNumUninitialized(NumElements);
+    for(int32 index = 0; index < NumElements; ++index)
+    {
+        points[index] = randomStream.VRand() * randomStream.FRandRange(0.0f, 10000.0f);
+        rotators[index] = FRotator(randomStream.FRandRange(-90.0f, 90.0f), randomStream.FRandRange(-360.0f, 360.0f), randomStream.FRandRange(-180.0f, 180.0f));
+    }
+    const FVector reference(1234.5f, -678.9f, 5000.0f);
+
+    TArray<float> batch, expected;
+    expected.SetNumUninitialized(NumElements);
+
+    FMathHelpers::Dot_VectorArray2D(points, reference, batch);
+    for(int32 index = 0; index < NumElements; ++index)
+    {
+        expected[index] = FMathHelpers::Dot_VectorVector2D(points[index], reference);
+    }
+    TestArraysNearlyEqual(*this, TEXT("Dot_VectorArray2D"), batch, expected, 1.e-2, 1.e-6);
+
+    FMathHelpers::DistanceSquared_VectorArray2D(points, reference, batch);
+    for(int32 index = 0; index < NumElements; ++index)
+    {
+        expected[index] = FVector::DistSquared2D(points[index], reference);
+    }
+    TestArraysNearlyEqual(*this, TEXT("DistanceSquared_VectorArray2D"), batch, expected, 1.e-2, 1.e-6);
+
+    // Brute force nearest, with a duplicate of it later in the array so the lowest index must win the tie
+    int32 expectedNearest = 0;
+    for(int32 index = 1; index < NumElements; ++index)
+    {
+        if(expected[index] < expected[expectedNearest])
+        {
+            expectedNearest = index;
+        }
+    }
+    points.Last() = points[expectedNearest];
+    float nearestDistanceSquared;
+    const int32 nearest = FMathHelpers::FindNearestPoint2D(points, reference, nearestDistanceSquared);
+    TestEqual(TEXT("FindNearestPoint2D index"), nearest, expectedNearest);
+    TestTrue(TEXT("FindNearestPoint2D distance"), FMath::IsNearlyEqual(nearestDistanceSquared, expected[expectedNearest], expected[expectedNearest] * 1.e-6f + 1.e-2f));
+    TestEqual(TEXT("FindNearestPoint2D of no points"), FMathHelpers::FindNearestPoint2D(TArray<FVector>(), reference, nearestDistanceSquared), static_cast<int32>(INDEX_NONE));
+
+    TArray<FVector> forwards;
+    FMathHelpers::GetForwardVectors2D(rotators, forwards);
+    TestEqual(TEXT("GetForwardVectors2D count"), forwards.Num(), NumElements);
+    for(int32 index = 0; index < FMath::Min(forwards.Num(), NumElements); ++index)
+    {
+        const FVector expectedForward = FMathHelpers::GetForwardVector2D(rotators[index]);
+        if(!forwards[index].Equals(expectedForward, 1.e-5f))
+        {
+            AddError(FString::Printf(TEXT("GetForwardVectors2D: [%d] is %s, expected %s"), index, *forwards[index].ToString(), *expectedForward.ToString()));
+            break;
+        }
+    }
+
+    return !HasAnyErrors();
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRyRuntimeFastMathBatchTest, "Ry.Runtime.Math.FastMathBatch", RyRuntimeTests::TestFlags)
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * The Fast*Array (and so Fast*Batch) functions against the scalar Fast* functions. They share coefficients, so may only
+ * differ in the last bits where one path contracts to FMA and the other doesn't.
+*/
+bool FRyRuntimeFastMathBatchTest::RunTest(const FString& Parameters)
+{
+    using namespace RyRuntimeTests;
+
+    FRandomStream randomStream(NumElements);
+    TArray<float> hyperbolic, angles, ys, xs;
+    MakeRandomFloats(randomStream, NumElements, -20.0f, 20.0f, hyperbolic);
+    MakeRandomFloats(randomStream, NumElements, -1000.0f, 1000.0f, angles);
+    MakeRandomFloats(randomStream, NumElements, -100.0f, 100.0f, ys);
+    MakeRandomFloats(randomStream, NumElements, -100.0f, 100.0f, xs);
+    // The axes, where Atan2 switches quadrant
+    xs[0] = 0.0f;
+    ys[1] = 0.0f;
+    xs[2] = -xs[2];
+    ys[2] = 0.0f;
+
+    TArray<float> batch, secondBatch, expected, secondExpected;
+    expected.SetNumUninitialized(NumElements);
+    secondExpected.SetNumUninitialized(NumElements);
+
+    FMathHelpers::FastSinHArray(hyperbolic, batch);
+    for(int32 index = 0; index < NumElements; ++index)
+    {
+        expected[index] = FMathHelpers::FastSinH(hyperbolic[index]);
+    }
+    TestArraysNearlyEqual(*this, TEXT("FastSinHArray"), batch, expected, 1.e-7, 1.e-6);
+
+    FMathHelpers::FastCosHArray(hyperbolic, batch);
+    for(int32 index = 0; index < NumElements; ++index)
+    {
+        expected[index] = FMathHelpers::FastCosH(hyperbolic[index]);
+    }
+    TestArraysNearlyEqual(*this, TEXT("FastCosHArray"), batch, expected, 0.0, 1.e-6);
+
+    FMathHelpers::FastSinCosArray(angles, batch, secondBatch);
+    for(int32 index = 0; index < NumElements; ++index)
+    {
+        FMathHelpers::FastSinCos(angles[index], expected[index], secondExpected[index]);
+    }
+    TestArraysNearlyEqual(*this, TEXT("FastSinCosArray sin"), batch, expected, 1.e-6);
+    TestArraysNearlyEqual(*this, TEXT("FastSinCosArray cos"), secondBatch, secondExpected, 1.e-6);
+
+    FMathHelpers::FastAtan2Array(ys, xs, batch);
+    for(int32 index = 0; index < NumElements; ++index)
+    {
+        expected[index] = FMathHelpers::FastAtan2(ys[index], xs[index]);
+    }
+    TestArraysNearlyEqual(*this, TEXT("FastAtan2Array"), batch, expected, 1.e-6);
+
+    FMathHelpers::FastCalculateCatenaryArray(hyperbolic, 3.0f, batch);
+    for(int32 index = 0; index < NumElements; ++index)
+    {
+        expected[index] = FMathHelpers::FastCalculateCatenary(hyperbolic[index], 3.0f);
+    }
+    TestArraysNearlyEqual(*this, TEXT("FastCalculateCatenaryArray"), batch, expected, 0.0, 1.e-6);
+
+    // In place, as the batch kernels allow
+    batch = hyperbolic;
+    FMathHelpers::FastSinHArray(batch, batch);
+    for(int32 index = 0; index < NumElements; ++index)
+    {
+        expected[index] = FMathHelpers::FastSinH(hyperbolic[index]);
+    }
+    TestArraysNearlyEqual(*this, TEXT("FastSinHArray in place"), batch, expected, 1.e-7, 1.e-6);
+
+    return !HasAnyErrors();
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRyRuntimeFastMathErrorBoundsTest, "Ry.Runtime.Math.FastMathErrorBounds", RyRuntimeTests::TestFlags)
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * The scalar and batch Fast* functions against double precision over their documented input ranges, failing if
+ * either exceeds the maximum error documented in RyRuntimeMathHelpers.h
+*/
+bool FRyRuntimeFastMathErrorBoundsTest::RunTest(const FString& Parameters)
+{
+    using namespace RyRuntimeTests;
+
+    // Half evenly spaced over the range (including both ends), half random
+    const int32 numSamples = 1 << 17;
+    auto makeInputs = [numSamples](FRandomStream& randomStream, const float min, const float max)
+    {
+        TArray<float> inputs;
+        inputs.SetNumUninitialized(numSamples);
+        const int32 numSwept = numSamples / 2;
+        for(int32 index = 0; index < numSwept; ++index)
+        {
+            inputs[index] = FMath::Lerp(min, max, static_cast<float>(index) / (numSwept - 1));
+        }
+        for(int32 index = numSwept; index < numSamples; ++index)
+        {
+            inputs[index] = randomStream.FRandRange(min, max);
+        }
+        return inputs;
+    };
+
+    // Largest error of the scalar and batch results, relative to bound(expected), which must stay <= 1
+    auto checkBound = [this, numSamples](const TCHAR* function, const TArray<float>& scalar, const TArray<float>& batch,
+                                         TFunctionRef<double(int32)> reference, TFunctionRef<double(int32, double)> bound)
+    {
+        double worstRatio = 0.0;
+        int32 worstIndex = 0;
+        for(int32 index = 0; index < numSamples; ++index)
+        {
+            const double expected = reference(index);
+            const double error = FMath::Max(FMath::Abs(scalar[index] - expected), FMath::Abs(batch[index] - expected));
+            const double ratio = error / bound(index, expected);
+            if(!(ratio <= worstRatio))
+            {
+                worstRatio = ratio;
+                worstIndex = index;
+            }
+        }
+
+        AddInfo(FString::Printf(TEXT("%s: worst error is %.3f of the documented bound"), function, worstRatio));
+        if(!(worstRatio <= 1.0))
+        {
+            AddError(FString::Printf(TEXT("%s: error at input %d is %.3f times the documented bound (scalar %.9g, batch %.9g, expected %.9g)"),
+                                     function, worstIndex, worstRatio, scalar[worstIndex], batch[worstIndex], reference(worstIndex)));
+        }
+    };
+
+    FRandomStream randomStream(numSamples);
+    TArray<float> scalar, batch, secondScalar, secondBatch;
+    scalar.SetNumUninitialized(numSamples);
+    batch.SetNumUninitialized(numSamples);
+    secondScalar.SetNumUninitialized(numSamples);
+    secondBatch.SetNumUninitialized(numSamples);
+
+    // Relative bounds, with a floor at the smallest normal float for results which round to (or near) zero
+    auto relativeBound = [](const double maxRelativeError)
+    {
+        return [maxRelativeError](int32, const double expected) { return FMath::Max(maxRelativeError * FMath::Abs(expected), static_cast<double>(FLT_MIN)); };
+    };
+    auto absoluteBound = [](const double maxAbsoluteError)
+    {
+        return [maxAbsoluteError](int32, double) { return maxAbsoluteError; };
+    };
+
+    const TArray<float> exponents = makeInputs(randomStream, RyFastMath::ExpMin, RyFastMath::ExpMax);
+    for(int32 index = 0; index < numSamples; ++index)
+    {
+        scalar[index] = FMathHelpers::FastExp(exponents[index]);
+    }
+    checkBound(TEXT("FastExp"), scalar, scalar, [&exponents](const int32 index) { return exp(static_cast<double>(exponents[index])); }, relativeBound(2.5e-7));
+
+    for(int32 index = 0; index < numSamples; ++index)
+    {
+        scalar[index] = FMathHelpers::FastSinH(exponents[index]);
+    }
+    FMathHelpers::FastSinHBatch(exponents.GetData(), batch.GetData(), numSamples);
+    checkBound(TEXT("FastSinH"), scalar, batch, [&exponents](const int32 index) { return sinh(static_cast<double>(exponents[index])); }, relativeBound(4.5e-7));
+
+    for(int32 index = 0; index < numSamples; ++index)
+    {
+        scalar[index] = FMathHelpers::FastCosH(exponents[index]);
+    }
+    FMathHelpers::FastCosHBatch(exponents.GetData(), batch.GetData(), numSamples);
+    checkBound(TEXT("FastCosH"), scalar, batch, [&exponents](const int32 index) { return cosh(static_cast<double>(exponents[index])); }, relativeBound(3.5e-7));
+
+    const TArray<float> angles = makeInputs(randomStream, -1000.0f, 1000.0f);
+    for(int32 index = 0; index < numSamples; ++index)
+    {
+        FMathHelpers::FastSinCos(angles[index], scalar[index], secondScalar[index]);
+    }
+    FMathHelpers::FastSinCosBatch(angles.GetData(), batch.GetData(), secondBatch.GetData(), numSamples);
+    checkBound(TEXT("FastSinCos sin"), scalar, batch, [&angles](const int32 index) { return sin(static_cast<double>(angles[index])); }, absoluteBound(8.e-7));
+    checkBound(TEXT("FastSinCos cos"), secondScalar, secondBatch, [&angles](const int32 index) { return cos(static_cast<double>(angles[index])); }, absoluteBound(7.e-6));
+
+    // FastSin and FastCos on their own, the batch is the same kernel as above
+    for(int32 index = 0; index < numSamples; ++index)
+    {
+        scalar[index] = FMathHelpers::FastSin(angles[index]);
+        secondScalar[index] = FMathHelpers::FastCos(angles[index]);
+    }
+    checkBound(TEXT("FastSin"), scalar, scalar, [&angles](const int32 index) { return sin(static_cast<double>(angles[index])); }, absoluteBound(8.e-7));
+    checkBound(TEXT("FastCos"), secondScalar, secondScalar, [&angles](const int32 index) { return cos(static_cast<double>(angles[index])); }, absoluteBound(7.e-6));
+
+    // Every direction, at magnitudes from tiny to large
+    TArray<float> ys, xs;
+    ys.SetNumUninitialized(numSamples);
+    xs.SetNumUninitialized(numSamples);
+    for(int32 index = 0; index < numSamples; ++index)
+    {
+        const float angle = index < numSamples / 2 ? FMath::Lerp(-PI, PI, static_cast<float>(index) / (numSamples / 2 - 1)) : randomStream.FRandRange(-PI, PI);
+        const float magnitude = FMath::Pow(10.0f, randomStream.FRandRange(-6.0f, 6.0f));
+        ys[index] = static_cast<float>(sin(static_cast<double>(angle))) * magnitude;
+        xs[index] = static_cast<float>(cos(static_cast<double>(angle))) * magnitude;
+        scalar[index] = FMathHelpers::FastAtan2(ys[index], xs[index]);
+    }
+    FMathHelpers::FastAtan2Batch(ys.GetData(), xs.GetData(), batch.GetData(), numSamples);
+    checkBound(TEXT("FastAtan2"), scalar, batch,
+               [&ys, &xs](const int32 index) { return atan2(static_cast<double>(ys[index]), static_cast<double>(xs[index])); }, absoluteBound(2.e-6));
+
+    // Scaled so X / scalingFactor covers the whole FastCosH range
+    const float scalingFactor = 3.0f;
+    const TArray<float> catenaryXs = makeInputs(randomStream, RyFastMath::ExpMin * scalingFactor, RyFastMath::ExpMax * scalingFactor);
+    for(int32 index = 0; index < numSamples; ++index)
+    {
+        scalar[index] = FMathHelpers::FastCalculateCatenary(catenaryXs[index], scalingFactor);
+    }
+    FMathHelpers::FastCalculateCatenaryBatch(catenaryXs.GetData(), scalingFactor, batch.GetData(), numSamples);
+    checkBound(TEXT("FastCalculateCatenary"), scalar, batch,
+               [&catenaryXs, scalingFactor](const int32 index) { return scalingFactor * cosh(static_cast<double>(catenaryXs[index]) / scalingFactor); },
+               [&catenaryXs, scalingFactor](const int32 index, const double expected)
+               {
+                   return (3.e-7 + 6.e-8 * FMath::Abs(static_cast<double>(catenaryXs[index]) / scalingFactor)) * FMath::Abs(expected);
+               });
+
+    return !HasAnyErrors();
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRyRuntimeFloatArrayStatsTest, "Ry.Runtime.Math.FloatArrayStats", RyRuntimeTests::TestFlags)
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * The float array reductions against double precision, and the in place transforms against their scalar expressions
+*/
+bool FRyRuntimeFloatArrayStatsTest::RunTest(const FString& Parameters)
+{
+    using namespace RyRuntimeTests;
+
+    FRandomStream randomStream(NumElements);
+    TArray<float> values;
+    MakeRandomFloats(randomStream, NumElements, -100.0f, 100.0f, values);
+    // Repeat the extremes later on, the first of each must be the one returned
+    values[10] = -200.0f;
+    values[20] = 300.0f;
+    values[NumElements - 1] = -200.0f;
+    values[NumElements - 2] = 300.0f;
+
+    double sum = 0.0;
+    double sumAbs = 0.0;
+    for(const float value : values)
+    {
+        sum += value;
+        sumAbs += FMath::Abs(value);
+    }
+    const double mean = sum / NumElements;
+    double sumSquares = 0.0;
+    for(const float value : values)
+    {
+        sumSquares += FMath::Square(value - mean);
+    }
+
+    // The SIMD reductions add in a different order to a plain loop, so the tolerance scales with the magnitudes summed
+    TestTrue(TEXT("SumFloatArray"), FMath::Abs(FMathHelpers::SumFloatArray(values) - sum) <= sumAbs * 1.e-5);
+    TestTrue(TEXT("MeanFloatArray"), FMath::Abs(FMathHelpers::MeanFloatArray(values) - mean) <= sumAbs * 1.e-5 / NumElements);
+
+    float varianceMean;
+    const float variance = FMathHelpers::VarianceFloatArray(values, varianceMean);
+    const float sampleVariance = FMathHelpers::VarianceFloatArray(values, varianceMean, true);
+    TestTrue(TEXT("VarianceFloatArray"), FMath::Abs(variance - sumSquares / NumElements) <= sumSquares / NumElements * 1.e-4);
+    TestTrue(TEXT("VarianceFloatArray sample"), FMath::Abs(sampleVariance - sumSquares / (NumElements - 1)) <= sumSquares / (NumElements - 1) * 1.e-4);
+    TestTrue(TEXT("VarianceFloatArray mean"), FMath::Abs(varianceMean - mean) <= sumAbs * 1.e-5 / NumElements);
+
+    int32 minIndex, maxIndex;
+    TestEqual(TEXT("MinFloatArray"), FMathHelpers::MinFloatArray(values, minIndex), -200.0f);
+    TestEqual(TEXT("MinFloatArray index"), minIndex, 10);
+    TestEqual(TEXT("MaxFloatArray"), FMathHelpers::MaxFloatArray(values, maxIndex), 300.0f);
+    TestEqual(TEXT("MaxFloatArray index"), maxIndex, 20);
+
+    const TArray<float> empty;
+    TestEqual(TEXT("SumFloatArray of none"), FMathHelpers::SumFloatArray(empty), 0.0f);
+    TestEqual(TEXT("MinFloatArray of none"), FMathHelpers::MinFloatArray(empty, minIndex), 0.0f);
+    TestEqual(TEXT("MinFloatArray index of none"), minIndex, static_cast<int32>(INDEX_NONE));
+    TestEqual(TEXT("VarianceFloatArray of none"), FMathHelpers::VarianceFloatArray(empty, varianceMean), 0.0f);
+
+    TArray<float> targets, transformed, expected;
+    MakeRandomFloats(randomStream, NumElements, -100.0f, 100.0f, targets);
+    expected.SetNumUninitialized(NumElements);
+
+    transformed = values;
+    FMathHelpers::ScaleFloatArrayInline(transformed, -2.5f);
+    for(int32 index = 0; index < NumElements; ++index)
+    {
+        expected[index] = values[index] * -2.5f;
+    }
+    TestArraysNearlyEqual(*this, TEXT("ScaleFloatArrayInline"), transformed, expected, 0.0, 1.e-7);
+
+    transformed = values;
+    FMathHelpers::OffsetFloatArrayInline(transformed, 12.25f);
+    for(int32 index = 0; index < NumElements; ++index)
+    {
+        expected[index] = values[index] + 12.25f;
+    }
+    TestArraysNearlyEqual(*this, TEXT("OffsetFloatArrayInline"), transformed, expected, 1.e-5);
+
+    transformed = values;
+    FMathHelpers::ClampFloatArrayInline(transformed, -50.0f, 75.0f);
+    for(int32 index = 0; index < NumElements; ++index)
+    {
+        expected[index] = FMath::Clamp(values[index], -50.0f, 75.0f);
+    }
+    TestArraysNearlyEqual(*this, TEXT("ClampFloatArrayInline"), transformed, expected, 0.0);
+
+    transformed = values;
+    FMathHelpers::LerpFloatArrayInline(transformed, targets, 0.3f);
+    for(int32 index = 0; index < NumElements; ++index)
+    {
+        expected[index] = FMath::Lerp(values[index], targets[index], 0.3f);
+    }
+    TestArraysNearlyEqual(*this, TEXT("LerpFloatArrayInline"), transformed, expected, 1.e-4);
+
+    transformed = values;
+    FMathHelpers::NormalizeFloatArrayInline(transformed);
+    for(int32 index = 0; index < NumElements; ++index)
+    {
+        expected[index] = (values[index] + 200.0f) / 500.0f;
+    }
+    TestArraysNearlyEqual(*this, TEXT("NormalizeFloatArrayInline"), transformed, expected, 1.e-6);
+
+    transformed.Init(7.0f, 5);
+    FMathHelpers::NormalizeFloatArrayInline(transformed);
+    TestTrue(TEXT("NormalizeFloatArrayInline of equal values"), !transformed.ContainsByPredicate([](const float value) { return value != 0.0f; }));
+
+    return !HasAnyErrors();
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRyRuntimeSortIndicesTest, "Ry.Runtime.Math.SortIndices", RyRuntimeTests::TestFlags)
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * SortIndicesBy*Keys and TopKIndicesBy*Keys against a stable comparison sort of the indices. Keys are drawn from a
+ * small range so there are plenty of ties, which must keep their original order both ascending and descending.
+*/
+bool FRyRuntimeSortIndicesTest::RunTest(const FString& Parameters)
+{
+    using namespace RyRuntimeTests;
+
+    FRandomStream randomStream(NumElements);
+    TArray<float> floatKeys;
+    TArray<int32> intKeys;
+    floatKeys.SetNumUninitialized(NumElements);
+    intKeys.SetNumUninitialized(NumElements);
+    for(int32 index = 0; index < NumElements; ++index)
+    {
+        // Whole numbers, so there is no -0 for the reference sort to disagree about
+        floatKeys[index] = static_cast<float>(randomStream.RandRange(-64, 64)) * 1.5f;
+        intKeys[index] = randomStream.RandRange(-64, 64) * 1000003;
+    }
+    floatKeys[0] = -MAX_FLT;
+    floatKeys[1] = MAX_FLT;
+    intKeys[0] = MIN_int32;
+    intKeys[1] = MAX_int32;
+
+    auto makeExpected = [](const auto& keys, const bool descending)
+    {
+        TArray<int32> indices;
+        for(int32 index = 0; index < keys.Num(); ++index)
+        {
+            indices.Add(index);
+        }
+        indices.StableSort([&keys, descending](const int32 A, const int32 B) { return descending ? keys[A] > keys[B] : keys[A] < keys[B]; });
+        return indices;
+    };
+
+    const int32 topKs[] = {0, 1, 16, NumElements - 1, NumElements, NumElements + 5};
+    for(const bool descending : {false, true})
+    {
+        const TArray<int32> expectedByFloat = makeExpected(floatKeys, descending);
+        const TArray<int32> expectedByInt = makeExpected(intKeys, descending);
+        const FString order = descending ? TEXT("descending") : TEXT("ascending");
+
+        TArray<int32> sortedIndices;
+        FMathHelpers::SortIndicesByFloatKeys(floatKeys, sortedIndices, descending);
+        TestTrue(FString::Printf(TEXT("SortIndicesByFloatKeys %s"), *order), sortedIndices == expectedByFloat);
+        FMathHelpers::SortIndicesByIntKeys(intKeys, sortedIndices, descending);
+        TestTrue(FString::Printf(TEXT("SortIndicesByIntKeys %s"), *order), sortedIndices == expectedByInt);
+
+        for(const int32 k : topKs)
+        {
+            const int32 numExpected = FMath::Clamp(k, 0, NumElements);
+            const TArray<int32> expectedTopKByFloat(expectedByFloat.GetData(), numExpected);
+            const TArray<int32> expectedTopKByInt(expectedByInt.GetData(), numExpected);
+
+            FMathHelpers::TopKIndicesByFloatKeys(floatKeys, k, sortedIndices, descending);
+            TestTrue(FString::Printf(TEXT("TopKIndicesByFloatKeys k=%d %s"), k, *order), sortedIndices == expectedTopKByFloat);
+            FMathHelpers::TopKIndicesByIntKeys(intKeys, k, sortedIndices, descending);
+            TestTrue(FString::Printf(TEXT("TopKIndicesByIntKeys k=%d %s"), k, *order), sortedIndices == expectedTopKByInt);
+        }
+    }
+
+    // Signed zeros and infinities, which the radix key mapping has to order without a comparison
+    const TArray<float> specialKeys = {0.0f, -0.0f, INFINITY, -INFINITY, -1.0f, 1.0f};
+    TArray<int32> sortedIndices;
+    FMathHelpers::SortIndicesByFloatKeys(specialKeys, sortedIndices);
+    TestTrue(TEXT("SortIndicesByFloatKeys special values"), sortedIndices == TArray<int32>({3, 4, 1, 0, 5, 2}));
+
+    return !HasAnyErrors();
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRyRuntimeFillNoiseGridTest, "Ry.Runtime.Math.FillNoiseGrid", RyRuntimeTests::TestFlags)
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * FillNoiseGrid against SampleNoise at every sample, that the parallel fill matches the serial one, and that a strip or
+ * slice of a field sampled with fewer dimensions than the grid matches the full field
+*/
+bool FRyRuntimeFillNoiseGridTest::RunTest(const FString& Parameters)
+{
+    using namespace RyRuntimeTests;
+
+    const FVector origin(3.7f, -12.1f, 5.3f);
+    const FVector spacing(0.137f, 0.21f, 0.33f);
+    const FIntVector gridSize(37, 9, 3);
+    const int32 seed = 1234;
+
+    for(const ERyNoiseType noiseType : {ERyNoiseType::Value, ERyNoiseType::Perlin, ERyNoiseType::Simplex})
+    {
+        const FString noiseName = StaticEnum<ERyNoiseType>()->GetNameStringByValue(static_cast<int64>(noiseType));
+        for(int32 numDimensions = 1; numDimensions <= 3; ++numDimensions)
+        {
+            TArray<float> grid, expected;
+            FMathHelpers::FillNoiseGrid(noiseType, gridSize, origin, spacing, grid, seed, numDimensions, false);
+            expected.SetNumUninitialized(gridSize.X * gridSize.Y * gridSize.Z);
+            for(int32 z = 0; z < gridSize.Z; ++z)
+            {
+                for(int32 y = 0; y < gridSize.Y; ++y)
+                {
+                    for(int32 x = 0; x < gridSize.X; ++x)
+                    {
+                        const FVector position = origin + spacing * FVector(x, y, z);
+                        expected[x + gridSize.X * (y + gridSize.Y * z)] = FMathHelpers::SampleNoise(noiseType, position, seed, numDimensions);
+                    }
+                }
+            }
+            // Positions round a little differently in the grid, which the noise gradient turns into small differences
+            TestArraysNearlyEqual(*this, *FString::Printf(TEXT("FillNoiseGrid %s %dD"), *noiseName, numDimensions), grid, expected, 1.e-4);
+
+            // A strip of row 4 and slice 2, sampled on its own
+            TArray<float> strip;
+            const FVector stripOrigin(origin.X, origin.Y + spacing.Y * 4, origin.Z + spacing.Z * 2);
+            FMathHelpers::FillNoiseGrid(noiseType, FIntVector(gridSize.X, 1, 1), stripOrigin, spacing, strip, seed, numDimensions, false);
+            const TArray<float> row(grid.GetData() + gridSize.X * (4 + gridSize.Y * 2), gridSize.X);
+            TestArraysNearlyEqual(*this, *FString::Printf(TEXT("FillNoiseGrid %s %dD strip"), *noiseName, numDimensions), strip, row, 1.e-6);
+
+            // Axes past numDimensions don't change the noise
+            if(numDimensions < 3)
+            {
+                const TArray<float> firstSlice(grid.GetData(), gridSize.X * gridSize.Y);
+                const TArray<float> lastSlice(grid.GetData() + gridSize.X * gridSize.Y * (gridSize.Z - 1), gridSize.X * gridSize.Y);
+                TestArraysNearlyEqual(*this, *FString::Printf(TEXT("FillNoiseGrid %s %dD ignores Z"), *noiseName, numDimensions), lastSlice, firstSlice, 0.0);
+            }
+        }
+
+        // Large enough to go wide
+        TArray<float> serial, parallel;
+        const FIntVector largeGridSize(2000, 6, 2);
+        FMathHelpers::FillNoiseGrid(noiseType, largeGridSize, origin, spacing, serial, seed, 3, false);
+        FMathHelpers::FillNoiseGrid(noiseType, largeGridSize, origin, spacing, parallel, seed, 3, true);
+        TestArraysNearlyEqual(*this, *FString::Printf(TEXT("FillNoiseGrid %s parallel"), *noiseName), parallel, serial, 0.0);
+    }
+
+    TArray<float> invalid = {1.0f};
+    AddExpectedError(TEXT("FillNoiseGrid: Invalid grid size"), EAutomationExpectedErrorFlags::Contains, 1);
+    FMathHelpers::FillNoiseGrid(ERyNoiseType::Perlin, FIntVector(4, 0, 1), origin, spacing, invalid);
+    TestEqual(TEXT("FillNoiseGrid of an empty grid"), invalid.Num(), 0);
+
+    return !HasAnyErrors();
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRyRuntimeSimplifyPolylineTest, "Ry.Runtime.Component.SimplifyPolyline", RyRuntimeTests::TestFlags)
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * Both SimplifyPolyline methods keep the ends and return increasing indices, Douglas-Peucker keeps every dropped point
+ * within tolerance of the result, and maxPoints is respected
+*/
+bool FRyRuntimeSimplifyPolylineTest::RunTest(const FString& Parameters)
+{
+    using namespace RyRuntimeTests;
+
+    // A noisy trace with a sharp corner and a straight run of collinear points
+    FRandomStream randomStream(NumElements);
+    TArray<FVector> points;
+    for(int32 index = 0; index < NumElements; ++index)
+    {
+        const float along = index * 10.0f;
+        FVector point(along, FMath::Sin(along * 0.01f) * 500.0f + randomStream.FRandRange(-5.0f, 5.0f), randomStream.FRandRange(-2.0f, 2.0f));
+        if(index > NumElements / 2 && index < NumElements / 2 + 100)
+        {
+            point = FVector(along, 2000.0f, 0.0f);
+        }
+        points.Add(point);
+    }
+
+    auto checkResult = [this, &points](const FString& what, const TArray<FVector>& pointsOut, const TArray<int32>& keptIndices, const int32 maxPoints)
+    {
+        if(!TestTrue(what + TEXT(" keeps at least the ends"), keptIndices.Num() >= 2 && keptIndices.Num() == pointsOut.Num()))
+        {
+            return;
+        }
+        TestEqual(what + TEXT(" first index"), keptIndices[0], 0);
+        TestEqual(what + TEXT(" last index"), keptIndices.Last(), points.Num() - 1);
+        for(int32 keptIndex = 0; keptIndex < keptIndices.Num(); ++keptIndex)
+        {
+            if(keptIndex > 0 && keptIndices[keptIndex] <= keptIndices[keptIndex - 1])
+            {
+                AddError(FString::Printf(TEXT("%s: kept indices aren't increasing at %d"), *what, keptIndex));
+                return;
+            }
+            if(pointsOut[keptIndex] != points[keptIndices[keptIndex]])
+            {
+                AddError(FString::Printf(TEXT("%s: point %d isn't the kept point"), *what, keptIndex));
+                return;
+            }
+        }
+        if(maxPoints > 0)
+        {
+            TestTrue(what + TEXT(" respects maxPoints"), keptIndices.Num() <= maxPoints);
+        }
+    };
+
+    TArray<FVector> pointsOut;
+    TArray<int32> keptIndices;
+    for(const float tolerance : {1.0f, 20.0f, 200.0f})
+    {
+        const FString what = FString::Printf(TEXT("DouglasPeucker tolerance %g"), tolerance);
+        URyRuntimeComponentHelpers::SimplifyPolyline(points, ERyPolylineSimplification::DouglasPeucker, tolerance, 0, pointsOut, keptIndices);
+        checkResult(what, pointsOut, keptIndices, 0);
+        TestTrue(what + TEXT(" drops points"), keptIndices.Num() < points.Num());
+
+        float maxDistance = 0.0f;
+        for(int32 keptIndex = 1; keptIndex < keptIndices.Num(); ++keptIndex)
+        {
+            for(int32 pointIndex = keptIndices[keptIndex - 1] + 1; pointIndex < keptIndices[keptIndex]; ++pointIndex)
+            {
+                maxDistance = FMath::Max(maxDistance, FMath::PointDistToSegment(points[pointIndex], points[keptIndices[keptIndex - 1]], points[keptIndices[keptIndex]]));
+            }
+        }
+        TestTrue(FString::Printf(TEXT("%s max distance %g"), *what, maxDistance), maxDistance <= tolerance * (1.0f + 1.e-4f));
+    }
+
+    for(const float minArea : {10.0f, 2000.0f})
+    {
+        URyRuntimeComponentHelpers::SimplifyPolyline(points, ERyPolylineSimplification::Visvalingam, minArea, 0, pointsOut, keptIndices);
+        checkResult(FString::Printf(TEXT("Visvalingam area %g"), minArea), pointsOut, keptIndices, 0);
+    }
+
+    for(const int32 maxPoints : {2, 3, 50})
+    {
+        URyRuntimeComponentHelpers::SimplifyPolyline(points, ERyPolylineSimplification::DouglasPeucker, 0.0f, maxPoints, pointsOut, keptIndices);
+        checkResult(FString::Printf(TEXT("DouglasPeucker maxPoints %d"), maxPoints), pointsOut, keptIndices, maxPoints);
+        URyRuntimeComponentHelpers::SimplifyPolyline(points, ERyPolylineSimplification::Visvalingam, 0.0f, maxPoints, pointsOut, keptIndices);
+        checkResult(FString::Printf(TEXT("Visvalingam maxPoints %d"), maxPoints), pointsOut, keptIndices, maxPoints);
+    }
+
+    return !HasAnyErrors();
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRyRuntimeSplineDistanceTableTest, "Ry.Runtime.Component.SplineDistanceTable", RyRuntimeTests::TestFlags)
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * A baked distance table against the spline it was baked from, and SampleSplineDistanceTableBatch against
+ * SampleSplineDistanceTable, on a rotated, translated and non uniformly scaled spline
+*/
+bool FRyRuntimeSplineDistanceTableTest::RunTest(const FString& Parameters)
+{
+    using namespace RyRuntimeTests;
+
+    USplineComponent* spline = NewObject<USplineComponent>(GetTransientPackage());
+    spline->ClearSplinePoints(false);
+    for(int32 pointIndex = 0; pointIndex < 8; ++pointIndex)
+    {
+        // Uneven segments, so per segment sampling density matters
+        spline->AddSplinePoint(FVector(pointIndex * pointIndex * 150.0f, (pointIndex & 1) ? 400.0f : -400.0f, pointIndex * 50.0f), ESplineCoordinateSpace::Local, false);
+    }
+    spline->UpdateSpline();
+    spline->SetRelativeTransform(FTransform(FRotator(10.0f, 35.0f, -20.0f), FVector(100.0f, -2000.0f, 300.0f), FVector(1.5f, 2.0f, 0.5f)));
+
+    FRySplineDistanceTable table;
+    const float sampleSpacing = 10.0f;
+    TestTrue(TEXT("UpdateSplineDistanceTable builds"), URyRuntimeComponentHelpers::UpdateSplineDistanceTable(spline, table, sampleSpacing));
+    TestFalse(TEXT("UpdateSplineDistanceTable skips an unchanged spline"), URyRuntimeComponentHelpers::UpdateSplineDistanceTable(spline, table, sampleSpacing));
+    if(!TestTrue(TEXT("Table is built"), table.IsBuilt()))
+    {
+        return false;
+    }
+
+    const float splineLength = spline->GetSplineLength();
+    TestTrue(FString::Printf(TEXT("Table length %g matches spline length %g"), table.GetLength(), splineLength),
+             FMath::IsNearlyEqual(table.GetLength(), splineLength, splineLength * 0.01f));
+
+    float maxGap = 0.0f;
+    for(int32 sampleIndex = 1; sampleIndex < table.Distances.Num(); ++sampleIndex)
+    {
+        maxGap = FMath::Max(maxGap, table.Distances[sampleIndex] - table.Distances[sampleIndex - 1]);
+    }
+    TestTrue(FString::Printf(TEXT("Largest gap between samples %g"), maxGap), maxGap > 0.0f && maxGap <= sampleSpacing * 2.0f);
+
+    FRandomStream randomStream(NumElements);
+    TArray<float> distances;
+    MakeRandomFloats(randomStream, NumElements, 0.0f, table.GetLength(), distances);
+    distances[0] = 0.0f;
+    distances[1] = table.GetLength();
+    distances[2] = -100.0f;
+    distances[3] = table.GetLength() + 100.0f;
+
+    for(const ESplineCoordinateSpace::Type coordinateSpace : {ESplineCoordinateSpace::Local, ESplineCoordinateSpace::World})
+    {
+        const TCHAR* spaceName = coordinateSpace == ESplineCoordinateSpace::World ? TEXT("World") : TEXT("Local");
+        TArray<FTransform> transforms;
+        URyRuntimeComponentHelpers::SampleSplineDistanceTableBatch(table, distances, coordinateSpace, transforms);
+        if(!TestEqual(FString::Printf(TEXT("SampleSplineDistanceTableBatch %s count"), spaceName), transforms.Num(), NumElements))
+        {
+            continue;
+        }
+
+        const FVector expectedScale = coordinateSpace == ESplineCoordinateSpace::World ? spline->GetComponentScale() : FVector::OneVector;
+        for(int32 index = 0; index < NumElements; ++index)
+        {
+            FVector location, tangent;
+            FRotator rotation;
+            URyRuntimeComponentHelpers::SampleSplineDistanceTable(table, distances[index], coordinateSpace, location, rotation, tangent);
+
+            // Against the spline itself, allowing for the engine's own coarser distance reparameterisation
+            const FVector splineLocation = spline->GetLocationAtDistanceAlongSpline(FMath::Clamp(distances[index], 0.0f, splineLength), coordinateSpace);
+            if(!location.Equals(splineLocation, splineLength * 0.005f))
+            {
+                AddError(FString::Printf(TEXT("SampleSplineDistanceTable %s: at %g is %s, the spline has %s"), spaceName, distances[index],
+                                         *location.ToString(), *splineLocation.ToString()));
+                break;
+            }
+
+            const FTransform& transform = transforms[index];
+            if(!transform.GetLocation().Equals(location, 1.e-2f) || transform.GetRotation().AngularDistance(rotation.Quaternion()) > 1.e-3f
+               || !transform.GetScale3D().Equals(expectedScale, 1.e-4f))
+            {
+                AddError(FString::Printf(TEXT("SampleSplineDistanceTableBatch %s: at %g is %s, expected %s %s scale %s"), spaceName, distances[index],
+                                         *transform.ToString(), *location.ToString(), *rotation.ToString(), *expectedScale.ToString()));
+                break;
+            }
+        }
+    }
+
+    // Editing the spline rebuilds the table
+    spline->SetLocationAtSplinePoint(3, FVector(0.0f, 0.0f, 1000.0f), ESplineCoordinateSpace::Local);
+    TestTrue(TEXT("UpdateSplineDistanceTable rebuilds an edited spline"), URyRuntimeComponentHelpers::UpdateSplineDistanceTable(spline, table, sampleSpacing));
+
+    return !HasAnyErrors();
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
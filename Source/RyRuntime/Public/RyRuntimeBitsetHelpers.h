@@ -0,0 +1,222 @@
+// Copyright 2020-2021 Sheffer Online Services.
+// MIT License. See LICENSE for details.
+
+#pragma once
+
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "RyRuntimeBitsetHelpers.generated.h"
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+  * A fixed size array of bits packed into 64 bit words. Bit 0 is the lowest bit of the first word.
+  * Bits past NumBits in the last word are always kept zero, so word level operations never need to mask them.
+*/
+USTRUCT(BlueprintType)
+struct RYRUNTIME_API FRyBitset
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    TArray<uint64> Words;
+
+    UPROPERTY()
+    int32 NumBits = 0;
+
+    static constexpr int32 BitsPerWord = 64;
+
+    FRyBitset() {}
+    FRyBitset(const int32 numBits, const bool value) { Init(numBits, value); }
+
+    // Resize to numBits bits, all set to value
+    void Init(const int32 numBits, const bool value);
+
+    int32 NumWords() const { return Words.Num(); }
+
+    bool IsValidIndex(const int32 bitIndex) const { return bitIndex >= 0 && bitIndex < NumBits; }
+
+    bool GetBit(const int32 bitIndex) const
+    {
+        check(IsValidIndex(bitIndex));
+        return (Words[bitIndex / BitsPerWord] >> (bitIndex % BitsPerWord)) & 1;
+    }
+
+    void SetBit(const int32 bitIndex, const bool value)
+    {
+        check(IsValidIndex(bitIndex));
+        const uint64 mask = uint64(1) << (bitIndex % BitsPerWord);
+        uint64& word = Words[bitIndex / BitsPerWord];
+        word = value ? (word | mask) : (word & ~mask);
+    }
+
+    // Zero the bits past NumBits in the last word
+    void ClearUnusedBits()
+    {
+        const int32 usedBitsInLastWord = NumBits % BitsPerWord;
+        if(usedBitsInLastWord != 0)
+        {
+            Words.Last() &= (uint64(1) << usedBitsInLastWord) - 1;
+        }
+    }
+
+    // Call func(bitIndex) for every set bit in [startIndex, endIndex), in increasing order
+    template<typename FuncType>
+    void ForEachSetBit(int32 startIndex, int32 endIndex, FuncType func) const
+    {
+        startIndex = FMath::Max(startIndex, 0);
+        endIndex = FMath::Min(endIndex, NumBits);
+        if(startIndex >= endIndex)
+        {
+            return;
+        }
+
+        const int32 lastWordIndex = (endIndex - 1) / BitsPerWord;
+        int32 wordIndex = startIndex / BitsPerWord;
+        uint64 word = Words[wordIndex] & (~uint64(0) << (startIndex % BitsPerWord));
+        for(;;)
+        {
+            while(word != 0)
+            {
+                const int32 bitIndex = wordIndex * BitsPerWord + static_cast<int32>(FPlatformMath::CountTrailingZeros64(word));
+                if(bitIndex >= endIndex)
+                {
+                    return;
+                }
+                func(bitIndex);
+                word &= word - 1;
+            }
+            if(++wordIndex > lastWordIndex)
+            {
+                return;
+            }
+            word = Words[wordIndex];
+        }
+    }
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+  * Static Helper functions for bitsets. Whole-bitset operations work a word (or a SIMD register of words) at a time,
+  * so operating on e.g. a 256x256 grid of flags is a single call.
+  * When two bitsets of different sizes are combined, B is treated as truncated or zero extended to the size of A.
+*/
+UCLASS(meta=(BlueprintThreadSafe))
+class RYRUNTIME_API URyRuntimeBitsetHelpers : public UBlueprintFunctionLibrary
+{
+    GENERATED_BODY()
+public:
+
+    /**
+     * Make a bitset of numBits bits, all set to value
+    */
+    UFUNCTION(BlueprintPure, Category = "RyRuntime|Bitset")
+    static FRyBitset MakeBitset(const int32 numBits, const bool value = false);
+
+    /**
+     * Get the number of bits in the bitset
+    */
+    UFUNCTION(BlueprintPure, Category = "RyRuntime|Bitset")
+    static int32 GetNumBits(const FRyBitset& bitset);
+
+    /**
+     * Get a bit. Returns false if bitIndex is out of range.
+    */
+    UFUNCTION(BlueprintPure, Category = "RyRuntime|Bitset")
+    static bool GetBit(const FRyBitset& bitset, const int32 bitIndex);
+
+    /**
+     * Set a bit. Does nothing if bitIndex is out of range.
+    */
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|Bitset")
+    static void SetBit(UPARAM(ref) FRyBitset& bitset, const int32 bitIndex, const bool value);
+
+    /**
+     * Set numBits bits starting at startIndex to value. The range is clamped to the bitset.
+    */
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|Bitset")
+    static void SetBitRange(UPARAM(ref) FRyBitset& bitset, const int32 startIndex, const int32 numBits, const bool value);
+
+    /**
+     * Set every bit to value
+    */
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|Bitset")
+    static void SetAllBits(UPARAM(ref) FRyBitset& bitset, const bool value);
+
+    /** Bitwise AND (A & B) */
+    UFUNCTION(BlueprintPure, meta = (DisplayName = "Bitwise AND", CompactNodeTitle = "&", Keywords = "& and"), Category = "RyRuntime|Bitset")
+    static FRyBitset And_BitsetBitset(const FRyBitset& A, const FRyBitset& B);
+
+    /** Bitwise OR (A | B) */
+    UFUNCTION(BlueprintPure, meta = (DisplayName = "Bitwise OR", CompactNodeTitle = "|", Keywords = "| or"), Category = "RyRuntime|Bitset")
+    static FRyBitset Or_BitsetBitset(const FRyBitset& A, const FRyBitset& B);
+
+    /** Bitwise XOR (A ^ B) */
+    UFUNCTION(BlueprintPure, meta = (DisplayName = "Bitwise XOR", CompactNodeTitle = "^", Keywords = "^ xor"), Category = "RyRuntime|Bitset")
+    static FRyBitset Xor_BitsetBitset(const FRyBitset& A, const FRyBitset& B);
+
+    /** Bitwise NOT (~A) */
+    UFUNCTION(BlueprintPure, meta = (DisplayName = "Bitwise NOT", CompactNodeTitle = "~", Keywords = "~ not"), Category = "RyRuntime|Bitset")
+    static FRyBitset Not_Bitset(const FRyBitset& A);
+
+    /** In place bitwise AND (A &= B). Avoids the copy of the pure version. */
+    UFUNCTION(BlueprintCallable, meta = (DisplayName = "Bitwise AND Assign", Keywords = "&= and"), Category = "RyRuntime|Bitset")
+    static void AndAssign_Bitset(UPARAM(ref) FRyBitset& A, const FRyBitset& B);
+
+    /** In place bitwise OR (A |= B). Avoids the copy of the pure version. */
+    UFUNCTION(BlueprintCallable, meta = (DisplayName = "Bitwise OR Assign", Keywords = "|= or"), Category = "RyRuntime|Bitset")
+    static void OrAssign_Bitset(UPARAM(ref) FRyBitset& A, const FRyBitset& B);
+
+    /** In place bitwise XOR (A ^= B). Avoids the copy of the pure version. */
+    UFUNCTION(BlueprintCallable, meta = (DisplayName = "Bitwise XOR Assign", Keywords = "^= xor"), Category = "RyRuntime|Bitset")
+    static void XorAssign_Bitset(UPARAM(ref) FRyBitset& A, const FRyBitset& B);
+
+    /** In place bitwise AND NOT (A &= ~B). Clears every bit of A which is set in B. */
+    UFUNCTION(BlueprintCallable, meta = (DisplayName = "Bitwise AND NOT Assign", Keywords = "clear mask"), Category = "RyRuntime|Bitset")
+    static void AndNotAssign_Bitset(UPARAM(ref) FRyBitset& A, const FRyBitset& B);
+
+    /** In place bitwise NOT (A = ~A) */
+    UFUNCTION(BlueprintCallable, meta = (DisplayName = "Bitwise NOT Assign", Keywords = "~ not invert"), Category = "RyRuntime|Bitset")
+    static void NotAssign_Bitset(UPARAM(ref) FRyBitset& A);
+
+    /** Bitwise Shift Left <<. Moves bit i to bit i + shift, bits shifted past the end are lost. */
+    UFUNCTION(BlueprintPure, meta = (DisplayName = "Bitwise Shift Left", CompactNodeTitle = "<<", Keywords = "<< shift"), Category = "RyRuntime|Bitset")
+    static FRyBitset ShiftLeft_Bitset(const FRyBitset& A, const int32 shift = 1);
+
+    /** Bitwise Shift Right >>. Moves bit i to bit i - shift, bits shifted below 0 are lost. */
+    UFUNCTION(BlueprintPure, meta = (DisplayName = "Bitwise Shift Right", CompactNodeTitle = ">>", Keywords = ">> shift"), Category = "RyRuntime|Bitset")
+    static FRyBitset ShiftRight_Bitset(const FRyBitset& A, const int32 shift = 1);
+
+    /** Returns true if A and B are the same size and have the same bits set */
+    UFUNCTION(BlueprintPure, meta = (DisplayName = "Equal (Bitset)", CompactNodeTitle = "==", Keywords = "== equal"), Category = "RyRuntime|Bitset")
+    static bool EqualEqual_BitsetBitset(const FRyBitset& A, const FRyBitset& B);
+
+    /**
+     * Count the number of set bits (population count)
+    */
+    UFUNCTION(BlueprintPure, Category = "RyRuntime|Bitset")
+    static int32 CountSetBits(const FRyBitset& bitset);
+
+    /**
+     * Returns true if any bit is set
+    */
+    UFUNCTION(BlueprintPure, Category = "RyRuntime|Bitset")
+    static bool AnyBitSet(const FRyBitset& bitset);
+
+    /**
+     * Find the index of the first set bit at or after startIndex. Returns IndexNone if there isn't one.
+    */
+    UFUNCTION(BlueprintPure, Category = "RyRuntime|Bitset")
+    static int32 FindFirstSetBit(const FRyBitset& bitset, const int32 startIndex = 0);
+
+    /**
+     * Find the index of the first unset bit at or after startIndex. Returns IndexNone if there isn't one.
+    */
+    UFUNCTION(BlueprintPure, Category = "RyRuntime|Bitset")
+    static int32 FindFirstUnsetBit(const FRyBitset& bitset, const int32 startIndex = 0);
+
+    /**
+     * Get the indices of all set bits in the range [startIndex, startIndex + numBits), in increasing order.
+     * @param numBits - The number of bits to visit. Negative visits every bit from startIndex to the end.
+    */
+    UFUNCTION(BlueprintPure, Category = "RyRuntime|Bitset")
+    static void GetSetBitIndices(const FRyBitset& bitset, TArray<int32>& indicesOut, const int32 startIndex = 0, const int32 numBits = -1);
+};
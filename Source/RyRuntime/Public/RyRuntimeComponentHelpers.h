@@ -8,6 +8,115 @@
 
 #include "RyRuntimeComponentHelpers.generated.h"
 
+// Polyline simplification algorithms, see SimplifyPolyline
+UENUM(BlueprintType)
+enum class ERyPolylineSimplification : uint8
+{
+	// Keeps the points furthest from the simplified line. Tolerance is a distance.
+	DouglasPeucker,
+	// Drops the points which add the least area. Tolerance is a triangle area. Gives smoother results on noisy traces.
+	Visvalingam,
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+  * A spline baked into dense samples by arc length, for fast distance queries. Samples are in the spline's local space.
+  * Build and refresh it with URyRuntimeComponentHelpers::UpdateSplineDistanceTable, which only rebuilds when the spline's
+  * curves have changed.
+*/
+USTRUCT(BlueprintType)
+struct RYRUNTIME_API FRySplineDistanceTable
+{
+	GENERATED_BODY()
+
+	// Distance along the spline of each sample, increasing
+	UPROPERTY()
+	TArray<float> Distances;
+
+	UPROPERTY()
+	TArray<FVector> Locations;
+
+	UPROPERTY()
+	TArray<FVector> Tangents;
+
+	UPROPERTY()
+	TArray<FQuat> Rotations;
+
+	// The spline baked into the table
+	UPROPERTY()
+	TWeakObjectPtr<class USplineComponent> Spline;
+
+	// Hash of the spline's curves when baked
+	UPROPERTY()
+	uint32 SplineHash = 0;
+
+	UPROPERTY()
+	float SampleSpacing = 0.0f;
+
+	UPROPERTY()
+	bool ClosedLoop = false;
+
+	bool IsBuilt() const { return Distances.Num() >= 2; }
+
+	float GetLength() const { return IsBuilt() ? Distances.Last() : 0.0f; }
+
+	// Sample at distance in local space. Distance is clamped to the spline, or wrapped for closed loops.
+	void Sample(float distance, FVector& locationOut, FQuat& rotationOut, FVector& tangentOut) const;
+};
+
+// Result of a batch component operation
+USTRUCT(BlueprintType)
+struct RYRUNTIME_API FRyComponentBatchStats
+{
+	GENERATED_BODY()
+
+	// Destination components processed
+	UPROPERTY(BlueprintReadOnly, Category = "RyRuntime|ComponentHelpers")
+	int32 NumComponents = 0;
+
+	// Destination components which were actually changed
+	UPROPERTY(BlueprintReadOnly, Category = "RyRuntime|ComponentHelpers")
+	int32 NumChanged = 0;
+
+	// Null destinations which were skipped
+	UPROPERTY(BlueprintReadOnly, Category = "RyRuntime|ComponentHelpers")
+	int32 NumSkipped = 0;
+
+	// Game thread time taken by the call
+	UPROPERTY(BlueprintReadOnly, Category = "RyRuntime|ComponentHelpers")
+	float Milliseconds = 0.0f;
+};
+
+// Result of ConvertStaticMeshesToInstances
+USTRUCT(BlueprintType)
+struct RYRUNTIME_API FRyInstancingStats
+{
+	GENERATED_BODY()
+
+	// Static mesh components moved into instanced components
+	UPROPERTY(BlueprintReadOnly, Category = "RyRuntime|ComponentHelpers")
+	int32 NumConverted = 0;
+
+	// Components which couldn't be instanced (null, no mesh, already instanced, simulating physics, or the owner's root)
+	UPROPERTY(BlueprintReadOnly, Category = "RyRuntime|ComponentHelpers")
+	int32 NumSkipped = 0;
+
+	// Instanced components created, one per mesh, material and collision combination
+	UPROPERTY(BlueprintReadOnly, Category = "RyRuntime|ComponentHelpers")
+	int32 NumInstancedComponents = 0;
+
+	// Estimated draw calls of the converted components before and after, one per LOD0 mesh section per component
+	UPROPERTY(BlueprintReadOnly, Category = "RyRuntime|ComponentHelpers")
+	int32 DrawCallsBefore = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "RyRuntime|ComponentHelpers")
+	int32 DrawCallsAfter = 0;
+
+	// Game thread time taken by the call
+	UPROPERTY(BlueprintReadOnly, Category = "RyRuntime|ComponentHelpers")
+	float Milliseconds = 0.0f;
+};
+
 //---------------------------------------------------------------------------------------------------------------------
 /**
 * Static Helper functions related to components in general. Adding extra functionality to components that exist with the
@@ -29,6 +138,74 @@ class RYRUNTIME_API URyRuntimeComponentHelpers : public UBlueprintFunctionLibrar
     								     ESplineCoordinateSpace::Type coordinateSpace,
     								     bool updateSpline = true);
 
+	// Replace all points of splineComponent with points in one write to its SplineCurves, instead of one
+	// SetLocationAtSplinePoint per point. The spline is resized as needed, so it doesn't need to be pre-populated.
+	// Existing point rotations and scales are kept for indices which still exist. Tangents are auto computed once by UpdateSpline.
+	// @param numSplinePoints - Points to give the spline (at least 2). <= 0 uses the number of input points.
+	// @param resampleByArcLength - Place spline points evenly by distance along the input polyline, rather than evenly by input index.
+	//                              Keeps spline points evenly spaced when the input is sampled unevenly (e.g. GPS traces).
+	//                              Applies even when numSplinePoints matches the input. Pass false to keep the input points as they are.
+	// @param updateSpline - Call UpdateSpline when done. If false, the caller must call it before the spline is evaluated.
+	UFUNCTION(BlueprintCallable, Category = "RyRuntime|ComponentHelpers", meta = (AdvancedDisplay = "3"))
+	static void SetSplinePointsBulk(class USplineComponent* splineComponent,
+	                                const TArray<FVector>& points,
+	                                ESplineCoordinateSpace::Type coordinateSpace,
+	                                const int32 numSplinePoints = 0,
+	                                const bool resampleByArcLength = true,
+	                                bool updateSpline = true);
+
+	// Resample a polyline to numPoints points, evenly spaced by distance along it. The first and last points are kept exactly.
+	UFUNCTION(BlueprintPure, Category = "RyRuntime|ComponentHelpers")
+	static void ResamplePolylineByArcLength(const TArray<FVector>& points, const int32 numPoints, TArray<FVector>& pointsOut);
+
+	// Simplify points, then replace the points of splineComponent with the simplified set using SetSplinePointsBulk.
+	// Unlike DistributePointsToSpline, the spline's point count follows the shape of the input rather than being fixed,
+	// so a dense trace becomes a few well placed spline points instead of being decimated by index.
+	// See SimplifyPolyline for tolerance and maxPoints.
+	UFUNCTION(BlueprintCallable, Category = "RyRuntime|ComponentHelpers", meta = (AdvancedDisplay = "5"))
+	static void DistributeSimplifiedPointsToSpline(class USplineComponent* splineComponent,
+	                                               const TArray<FVector>& points,
+	                                               ESplineCoordinateSpace::Type coordinateSpace,
+	                                               const ERyPolylineSimplification method,
+	                                               const float tolerance,
+	                                               const int32 maxPoints = 0,
+	                                               bool updateSpline = true);
+
+	// Reduce a polyline to fewer points which keep its shape. The first and last points are always kept.
+	// @param tolerance - Douglas-Peucker: max distance of a dropped point from the result. Visvalingam: min area of a kept point's triangle.
+	//                    <= 0 ignores the tolerance, so only maxPoints limits the result.
+	// @param maxPoints - Max points in the result (at least 2). <= 0 ignores the count, so only tolerance limits the result.
+	// @param keptIndicesOut - Indices into points of the kept points, in increasing order
+	UFUNCTION(BlueprintPure, Category = "RyRuntime|ComponentHelpers", meta = (AdvancedDisplay = "3"))
+	static void SimplifyPolyline(const TArray<FVector>& points, const ERyPolylineSimplification method, const float tolerance,
+	                             const int32 maxPoints, TArray<FVector>& pointsOut, TArray<int32>& keptIndicesOut);
+
+	// Native versions of SimplifyPolyline, writing the kept indices in increasing order
+	static void SimplifyPolylineDouglasPeucker(const TArray<FVector>& points, const float tolerance, const int32 maxPoints, TArray<int32>& keptIndicesOut);
+	static void SimplifyPolylineVisvalingam(const TArray<FVector>& points, const float minArea, const int32 maxPoints, TArray<int32>& keptIndicesOut);
+
+	// Bake splineComponent into table, if the table isn't built from it yet or the spline's curves have changed since.
+	// Returns true if the table was rebuilt. Cheap to call every frame, checking for changes only hashes the spline points.
+	// @param sampleSpacing - Distance between samples. Smaller is more accurate on tight curves, but uses more memory.
+	// @param forceRebuild - Rebuild even if the spline hasn't changed
+	UFUNCTION(BlueprintCallable, Category = "RyRuntime|ComponentHelpers|Spline", meta = (AdvancedDisplay = "2"))
+	static bool UpdateSplineDistanceTable(class USplineComponent* splineComponent, UPARAM(ref) FRySplineDistanceTable& table,
+	                                      const float sampleSpacing = 10.0f, const bool forceRebuild = false);
+
+	// Get the location, rotation and tangent at distance along a baked spline. A binary search and lerp, much cheaper than
+	// GetLocationAtDistanceAlongSpline and friends. World space uses the current transform of the table's spline.
+	UFUNCTION(BlueprintPure, Category = "RyRuntime|ComponentHelpers|Spline")
+	static void SampleSplineDistanceTable(const FRySplineDistanceTable& table, const float distance, ESplineCoordinateSpace::Type coordinateSpace,
+	                                      FVector& location, FRotator& rotation, FVector& tangent);
+
+	// Get the transforms at many distances along a baked spline in one call. World space transforms carry the spline's scale.
+	UFUNCTION(BlueprintPure, Category = "RyRuntime|ComponentHelpers|Spline")
+	static void SampleSplineDistanceTableBatch(const FRySplineDistanceTable& table, const TArray<float>& distances,
+	                                           ESplineCoordinateSpace::Type coordinateSpace, TArray<FTransform>& transformsOut);
+
+	// Hash of the position, rotation and scale curves of splineComponent, changes whenever the spline is edited
+	static uint32 HashSplineCurves(const class USplineComponent* splineComponent);
+
 	// Copy the collision properties from one primitive component to another.
 	// This does not copy custom profile overrides!
 	UFUNCTION(BlueprintCallable, Category = "RyRuntime|ComponentHelpers|Primitives")
@@ -38,4 +215,30 @@ class RYRUNTIME_API URyRuntimeComponentHelpers : public UBlueprintFunctionLibrar
 	// This iterates source meshes materials and assigns them to dest mesh.
 	UFUNCTION(BlueprintCallable, Category = "RyRuntime|ComponentHelpers|Primitives")
 	static void CopyMaterials(class UPrimitiveComponent* sourceMesh, class UPrimitiveComponent* destMesh);
+
+	// Copy the collision properties from one primitive component to many.
+	// Only the properties which differ are set, so destinations which already match pay no physics, overlap or navigation
+	// updates. Overlap updates from profile changes are deferred until every destination is changed, then done once per
+	// component. Physics filter and navigation updates are not deferred, each differing setter still applies its own, as
+	// the engine has no public way to change a registered body's profile without updating it.
+	// This does not copy custom profile overrides!
+	UFUNCTION(BlueprintCallable, Category = "RyRuntime|ComponentHelpers|Primitives")
+	static FRyComponentBatchStats CopyCollisionPropertiesBatch(class UPrimitiveComponent* sourceMesh, const TArray<class UPrimitiveComponent*>& destMeshes);
+
+	// Copy the materials of source mesh to many dest meshes.
+	// Only slots which differ are set, so dest meshes which already match are left untouched.
+	// Each differing slot goes through SetMaterial, which is not deferred further: it only marks the render state dirty,
+	// which the engine already recreates once at the end of the frame, and it keeps the material caches correct.
+	UFUNCTION(BlueprintCallable, Category = "RyRuntime|ComponentHelpers|Primitives")
+	static FRyComponentBatchStats CopyMaterialsBatch(class UPrimitiveComponent* sourceMesh, const TArray<class UPrimitiveComponent*>& destMeshes);
+
+	// Move static mesh components into hierarchical instanced static mesh components, one per group of components sharing
+	// the same mesh, materials, mobility, shadow casting and collision settings. Instances keep their world transforms.
+	// @param instanceOwner - Actor to create the instanced components on, attached to its root
+	// @param destroySourceComponents - Destroy the converted components. If false they are hidden and their collision disabled.
+	// @param instancedComponentsOut - The instanced components created
+	UFUNCTION(BlueprintCallable, Category = "RyRuntime|ComponentHelpers|Primitives", meta = (AdvancedDisplay = "2"))
+	static FRyInstancingStats ConvertStaticMeshesToInstances(class AActor* instanceOwner, const TArray<class UStaticMeshComponent*>& components,
+	                                                         const bool destroySourceComponents,
+	                                                         TArray<class UHierarchicalInstancedStaticMeshComponent*>& instancedComponentsOut);
 };
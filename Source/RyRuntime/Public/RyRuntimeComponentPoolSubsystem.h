@@ -0,0 +1,115 @@
+// Copyright 2020-2021 Sheffer Online Services.
+// MIT License. See LICENSE for details.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "RyRuntimeComponentPoolSubsystem.generated.h"
+
+class UActorComponent;
+class USceneComponent;
+
+// Counters of a component pool, totals are since the pool was created or stats were reset
+USTRUCT(BlueprintType)
+struct RYRUNTIME_API FRyComponentPoolStats
+{
+    GENERATED_BODY()
+
+    // Components handed out by AcquireComponent
+    UPROPERTY(BlueprintReadOnly, Category = "RyRuntime|ComponentPool")
+    int32 NumAcquired = 0;
+
+    // Acquires served from the pool, without a new allocation
+    UPROPERTY(BlueprintReadOnly, Category = "RyRuntime|ComponentPool")
+    int32 NumReused = 0;
+
+    // Acquires which had to create a new component
+    UPROPERTY(BlueprintReadOnly, Category = "RyRuntime|ComponentPool")
+    int32 NumCreated = 0;
+
+    // Components returned to the pool by ReleaseComponent
+    UPROPERTY(BlueprintReadOnly, Category = "RyRuntime|ComponentPool")
+    int32 NumReleased = 0;
+
+    // Released components destroyed because their class's pool was full
+    UPROPERTY(BlueprintReadOnly, Category = "RyRuntime|ComponentPool")
+    int32 NumDestroyed = 0;
+
+    // Components currently waiting in the pool, over all classes
+    UPROPERTY(BlueprintReadOnly, Category = "RyRuntime|ComponentPool")
+    int32 NumPooled = 0;
+};
+
+// The free components of one class
+USTRUCT()
+struct FRyComponentPoolEntry
+{
+    GENERATED_BODY()
+
+    UPROPERTY(Transient)
+    TArray<UActorComponent*> Components;
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+  * A world subsystem which recycles components per class, for components which are added and removed frequently
+  * (decals, audio, particles...). AcquireComponent is a pooled URyRuntimeLevelHelpers::CreateComponentForActor, and
+  * ReleaseComponent replaces DestroyComponent.
+  * Released components are unregistered, detached and moved out of their owner, and moved into the next owner when
+  * reacquired, so no allocation happens. Their properties are otherwise left as they were, so reset anything the next
+  * user relies on.
+  * Profile with "stat RyRuntime".
+*/
+UCLASS()
+class RYRUNTIME_API URyRuntimeComponentPoolSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+public:
+
+    /** USubsystem implementation */
+    virtual void Deinitialize() override;
+
+    // Get a registered component of componentClass owned by owner, reusing a pooled one if there is one.
+    // @param attachComponent - Scene component to attach to. If owner is null, the owner of attachComponent is used.
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|ComponentPool", meta = (DeterminesOutputType = "componentClass"))
+    UActorComponent* AcquireComponent(AActor* owner, TSubclassOf<UActorComponent> componentClass, USceneComponent* attachComponent = nullptr);
+
+    // Give a component back to the pool. It is deactivated, detached and unregistered, and must not be used afterwards.
+    // Returns true if it was pooled, false if it was destroyed because its class's pool is full or it is invalid.
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|ComponentPool")
+    bool ReleaseComponent(UActorComponent* component);
+
+    // Create pooled components of componentClass up front, so later acquires don't allocate
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|ComponentPool")
+    void PrewarmPool(TSubclassOf<UActorComponent> componentClass, const int32 numComponents);
+
+    // Destroy every pooled component
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|ComponentPool")
+    void ClearPool();
+
+    // Set the most components kept per class. Releases past this destroy the component instead.
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|ComponentPool")
+    void SetMaxPooledPerClass(const int32 maxPooledPerClass) { MaxPooledPerClass = FMath::Max(maxPooledPerClass, 0); }
+
+    // Returns the number of pooled components of componentClass
+    UFUNCTION(BlueprintPure, Category = "RyRuntime|ComponentPool")
+    int32 GetNumPooled(TSubclassOf<UActorComponent> componentClass) const;
+
+    UFUNCTION(BlueprintPure, Category = "RyRuntime|ComponentPool")
+    FRyComponentPoolStats GetPoolStats() const { return Stats; }
+
+    // Zero the totals, NumPooled is kept
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|ComponentPool")
+    void ResetPoolStats();
+
+private:
+
+    // Move component to a new outer, keeping its name unless it is taken there
+    static void MoveComponentTo(UActorComponent* component, UObject* newOuter);
+
+    UPROPERTY(Transient)
+    TMap<UClass*, FRyComponentPoolEntry> Pools;
+
+    FRyComponentPoolStats Stats;
+    int32 MaxPooledPerClass = 64;
+};
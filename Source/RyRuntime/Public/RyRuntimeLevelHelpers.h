@@ -110,6 +110,13 @@ public:
     UFUNCTION(BlueprintCallable, Category = "RyRuntime|LevelHelpers")
     static UObject* FindObjectInLevelByName(ULevel* levelToSearch, const FString& nameToFind);
 
+    // Searches the level package for many objects by name in one pass.
+    // objectsOut is aligned to namesToFind, an entry is None if that name could not be found.
+    // Uses a per level name map which is cached by the world, so resolving thousands of names (ex: when restoring level state)
+    // doesn't pay for a search through the global object table per name.
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|LevelHelpers")
+    static void FindObjectsInLevelByNames(ULevel* levelToSearch, const TArray<FString>& namesToFind, TArray<UObject*>& objectsOut);
+
     // Gets all actors of ActorClass in a specific level
     // This is a slow operation, use with caution e.g. do not use every frame.
     UFUNCTION(BlueprintCallable, Category = "RyRuntime|LevelHelpers")
@@ -170,6 +177,7 @@ public:
 	static void FinishSpawningDeferredActor(AActor* actorToFinishSpawning, const FTransform& newTransform, bool useNewTransform = false);
 
     // A Helper function to create a component of a class type and attach it to the actor at runtime. This does not support presenting exposed variables.
+    // For components which are added and removed frequently, URyRuntimeComponentPoolSubsystem::AcquireComponent reuses released ones instead.
     UFUNCTION(BlueprintCallable, Category = "RyRuntime|LevelHelpers")
     static class UActorComponent* CreateComponentForActor(AActor *owner, TSubclassOf<class UActorComponent> newComponentClass,
                                                           class USceneComponent *attachComponent = nullptr, const FName newName = NAME_None);
@@ -194,6 +202,23 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "RyRuntime|LevelHelpers")
     static bool TeleportToAdvanced(AActor *ActorToTeleport, const FVector& DestLocation, const FRotator& DestRotation, bool IsATest=false, bool NoCheck=false);
 
+	/**
+	* Batch version of TeleportToAdvanced for moving many actors at once (squads, puzzle room resets, etc).
+	* Movement of every actor's root component is scoped so overlap and physics updates are deferred and committed
+	* once after all actors have been moved, instead of once per actor.
+	*
+	* @param ActorsToTeleport The actors to teleport
+	* @param DestLocations The target destination points, aligned to ActorsToTeleport
+	* @param DestRotations The target rotations at the destinations, aligned to ActorsToTeleport
+	* @param SuccessOut Per actor result aligned to ActorsToTeleport. False if the actor was invalid or couldn't fit.
+	* @param IsATest is true if this is a test movement, which shouldn't cause any notifications (used by AI pathfinding, for example)
+	* @param NoCheck is true if we should skip checking for encroachment in the world or other actors
+	* @return The number of actors successfully moved
+	*/
+	UFUNCTION(BlueprintCallable, Category = "RyRuntime|LevelHelpers", meta = (AdvancedDisplay = "4"))
+	static int32 TeleportActorsAdvanced(const TArray<AActor*>& ActorsToTeleport, const TArray<FVector>& DestLocations, const TArray<FRotator>& DestRotations,
+	                                    TArray<bool>& SuccessOut, bool IsATest=false, bool NoCheck=false);
+
 	/**  
 	* Stream in a level with a specific location and rotation.
 	* This is an advanced implementation with extended control of how the level is loaded.
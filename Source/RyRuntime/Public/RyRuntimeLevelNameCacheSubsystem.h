@@ -0,0 +1,56 @@
+// Copyright 2020-2021 Sheffer Online Services.
+// MIT License. See LICENSE for details.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "RyRuntimeLevelNameCacheSubsystem.generated.h"
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+  * A world subsystem which caches a name to object map per level so large numbers of named objects can be resolved
+  * without a StaticFindObject walk through the global object table for each one.
+  * A level's map is built lazily on first use, and is kept up to date as actors are spawned and removed.
+  * Stale or missing entries fall back to StaticFindObject, so results always match FindObjectInLevelByName.
+*/
+UCLASS()
+class RYRUNTIME_API URyRuntimeLevelNameCacheSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+public:
+
+    /** USubsystem implementation */
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    // Find an object directly outered to levelToSearch by name
+    UObject* FindObjectInLevel(ULevel* levelToSearch, const FString& nameToFind);
+
+    // Resolve many names against levelToSearch in one pass. objectsOut is aligned to namesToFind, with nullptr for misses.
+    void FindObjectsInLevel(ULevel* levelToSearch, const TArray<FString>& namesToFind, TArray<UObject*>& objectsOut);
+
+    // Throw away the cached name map of a level. It will be rebuilt on next use.
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|LevelHelpers")
+    void InvalidateLevel(ULevel* level);
+
+    // Throw away the cached name maps of all levels
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|LevelHelpers")
+    void InvalidateAllLevels();
+
+private:
+
+    typedef TMap<FName, TWeakObjectPtr<UObject>> FLevelNameMap;
+
+    FLevelNameMap& GetLevelNameMap(ULevel* level);
+    UObject* FindInNameMap(ULevel* level, FLevelNameMap& nameMap, const FString& nameToFind);
+
+    void OnActorSpawned(AActor* spawnedActor);
+    void OnLevelActorDeleted(AActor* deletedActor);
+    void OnLevelRemovedFromWorld(ULevel* level, UWorld* world);
+
+    TMap<TWeakObjectPtr<ULevel>, FLevelNameMap> LevelNameMaps;
+
+    FDelegateHandle ActorSpawnedHandle;
+    FDelegateHandle LevelActorDeletedHandle;
+    FDelegateHandle LevelRemovedFromWorldHandle;
+};
@@ -0,0 +1,125 @@
+// Copyright 2020-2021 Sheffer Online Services.
+// MIT License. See LICENSE for details.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "RyRuntimeMaterialCacheSubsystem.generated.h"
+
+class UMaterialInterface;
+class UMaterialInstanceDynamic;
+class UPrimitiveComponent;
+class UTexture;
+
+// Parameter overrides for a shared dynamic material instance
+USTRUCT(BlueprintType)
+struct RYRUNTIME_API FRyMaterialParameterSet
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RyRuntime|MaterialCache")
+    TMap<FName, float> ScalarParameters;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RyRuntime|MaterialCache")
+    TMap<FName, FLinearColor> VectorParameters;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RyRuntime|MaterialCache")
+    TMap<FName, UTexture*> TextureParameters;
+
+    // Order independent hash of every parameter
+    uint32 GetHash() const;
+
+    bool operator==(const FRyMaterialParameterSet& other) const;
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+  * A world subsystem which shares dynamic material instances between components that use the same parent material with
+  * the same parameters, instead of each component creating its own. Fewer instances means fewer uniform buffer updates on
+  * the render thread and less memory.
+  * Shared instances are reference counted, and an instance is dropped from the cache (and left to garbage collection) when
+  * its count reaches zero. Every Acquire must be matched by a Release. Instances set with SetSharedMaterialOnComponent are
+  * instead held by the component's slot, which lets go when the slot is cleared or changed, or the component is destroyed.
+  * Dead slots are pruned before a new instance is created, so the cache doesn't grow with destroyed or recycled components.
+  * Shared instances must not have their parameters changed, as every user would see the change. Acquire one for the
+  * new parameters instead.
+  * Profile with "stat RyRuntime".
+*/
+UCLASS()
+class RYRUNTIME_API URyRuntimeMaterialCacheSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+public:
+
+    /** USubsystem implementation */
+    virtual void Deinitialize() override;
+
+    // Get the shared instance of parentMaterial with parameters, creating it if this combination hasn't been seen.
+    // Adds a reference which must be released with ReleaseSharedMaterial. Returns null if parentMaterial is null.
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|MaterialCache")
+    UMaterialInstanceDynamic* AcquireSharedMaterial(UMaterialInterface* parentMaterial, const FRyMaterialParameterSet& parameters);
+
+    // Release a reference from AcquireSharedMaterial. Returns false if material isn't a shared instance from this cache.
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|MaterialCache")
+    bool ReleaseSharedMaterial(UMaterialInstanceDynamic* material);
+
+    // Acquire the shared instance of parentMaterial with parameters and set it on a material slot of component.
+    // The slot holds the reference, released when the slot is cleared or set again, or once the component is destroyed or
+    // the slot is given another material. This can be called repeatedly to change a tint.
+    // Returns the instance set, or null if component or parentMaterial is null.
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|MaterialCache")
+    UMaterialInstanceDynamic* SetSharedMaterialOnComponent(UPrimitiveComponent* component, const int32 elementIndex,
+                                                           UMaterialInterface* parentMaterial, const FRyMaterialParameterSet& parameters);
+
+    // Release the shared instance on a material slot of component, if any, and restore the slot to its default material
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|MaterialCache")
+    void ClearSharedMaterialOnComponent(UPrimitiveComponent* component, const int32 elementIndex);
+
+    // Returns true if material is a shared instance from this cache
+    UFUNCTION(BlueprintPure, Category = "RyRuntime|MaterialCache")
+    bool IsSharedMaterial(const UMaterialInstanceDynamic* material) const { return MaterialInfos.Contains(material); }
+
+    // Returns the reference count of a shared instance (Acquire references plus live component slots), or 0 if it isn't one
+    UFUNCTION(BlueprintPure, Category = "RyRuntime|MaterialCache")
+    int32 GetSharedMaterialRefCount(const UMaterialInstanceDynamic* material) const;
+
+    // Returns the number of shared instances alive in the cache
+    UFUNCTION(BlueprintPure, Category = "RyRuntime|MaterialCache")
+    int32 GetNumSharedMaterials() const { return SharedMaterials.Num(); }
+
+private:
+
+    // A component material slot holding a shared instance
+    struct FHolder
+    {
+        TWeakObjectPtr<UPrimitiveComponent> Component;
+        int32 ElementIndex;
+    };
+
+    struct FSharedMaterialInfo
+    {
+        uint32 Hash;
+        // References from AcquireSharedMaterial
+        int32 RefCount;
+        FRyMaterialParameterSet Parameters;
+        // References from SetSharedMaterialOnComponent
+        TArray<FHolder> Holders;
+    };
+
+    static uint32 GetKeyHash(const UMaterialInterface* parentMaterial, const FRyMaterialParameterSet& parameters);
+    static bool IsHolderDead(const FHolder& holder, const UMaterialInstanceDynamic* material);
+
+    // Returns false if the slot wasn't holding material
+    bool RemoveHolder(UPrimitiveComponent* component, const int32 elementIndex, UMaterialInstanceDynamic* material);
+    void PruneDeadHolders();
+    void RemoveIfUnused(UMaterialInstanceDynamic* material, const FSharedMaterialInfo& info);
+
+    // Keeps the shared instances alive
+    UPROPERTY(Transient)
+    TArray<UMaterialInstanceDynamic*> SharedMaterials;
+
+    TMap<const UMaterialInstanceDynamic*, FSharedMaterialInfo> MaterialInfos;
+
+    // Parent and parameter hash to the shared instances with it, more than one only on hash collisions
+    TMultiMap<uint32, UMaterialInstanceDynamic*> MaterialsByHash;
+};
@@ -58,6 +58,207 @@ enum class ERyUnit : uint8
     Unspecified  UMETA(Hidden)
 };
 
+// A unit conversion resolved ahead of time into an affine transform (value * Scale + Offset).
+// Make one with MakeUnitConversionPlan and reuse it to convert many values without dispatching on the unit types each time.
+USTRUCT(BlueprintType)
+struct FRyUnitConversionPlan
+{
+	GENERATED_BODY()
+
+	/** The unit values are converted from */
+	UPROPERTY(BlueprintReadOnly, Category = UnitConversion)
+	ERyUnit From;
+
+	/** The unit values are converted to */
+	UPROPERTY(BlueprintReadOnly, Category = UnitConversion)
+	ERyUnit To;
+
+	/** Multiplier applied to the value */
+	UPROPERTY(BlueprintReadOnly, Category = UnitConversion)
+	float Scale;
+
+	/** Offset added after scaling (temperatures) */
+	UPROPERTY(BlueprintReadOnly, Category = UnitConversion)
+	float Offset;
+
+	/** False if From and To are not compatible units. An invalid plan leaves values unchanged. */
+	UPROPERTY(BlueprintReadOnly, Category = UnitConversion)
+	bool IsValid;
+
+	FRyUnitConversionPlan()
+		: From(ERyUnit::Unspecified)
+		, To(ERyUnit::Unspecified)
+		, Scale(1.0f)
+		, Offset(0.0f)
+		, IsValid(false)
+	{
+	}
+
+	FORCEINLINE float Convert(const float value) const
+	{
+		return value * Scale + Offset;
+	}
+};
+
+// A cable hanging between two points, solved into a catenary polyline by SolveCatenaryCable.
+// The solved points are cached with the inputs they were solved for, so re-solving a cable whose endpoints,
+// length and point count haven't changed is free.
+USTRUCT(BlueprintType)
+struct FRyCatenaryCable
+{
+	GENERATED_BODY()
+
+	/** World space start of the cable */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Catenary)
+	FVector Start;
+
+	/** World space end of the cable */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Catenary)
+	FVector End;
+
+	/** Length of the cable. If shorter than the distance between Start and End, the cable is pulled taut. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Catenary)
+	float Length;
+
+	/** Number of points in the solved polyline, including Start and End (>= 2) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Catenary)
+	int32 NumPoints;
+
+	/** The solved polyline from Start to End */
+	UPROPERTY(BlueprintReadOnly, Category = Catenary)
+	TArray<FVector> Points;
+
+	/** The solved scaling factor, see CalculateCatenary. Zero if the cable is taut. */
+	UPROPERTY(BlueprintReadOnly, Category = Catenary)
+	float ScalingFactor;
+
+	FRyCatenaryCable()
+		: Start(ForceInitToZero)
+		, End(ForceInitToZero)
+		, Length(0.0f)
+		, NumPoints(16)
+		, ScalingFactor(0.0f)
+		, SolvedStart(ForceInitToZero)
+		, SolvedEnd(ForceInitToZero)
+		, SolvedLength(-1.0f)
+	{
+	}
+
+	/** True if Points is up to date with Start, End, Length and NumPoints */
+	bool IsSolved() const
+	{
+		return Points.Num() == NumPoints && SolvedLength == Length && SolvedStart.Equals(Start) && SolvedEnd.Equals(End);
+	}
+
+private:
+	friend class URyRuntimeMathHelpers;
+
+	// The inputs Points was solved for
+	FVector SolvedStart;
+	FVector SolvedEnd;
+	float SolvedLength;
+};
+
+// Procedural noise algorithms, see FillNoiseGrid
+UENUM(BlueprintType)
+enum class ERyNoiseType : uint8
+{
+	/** Smoothly interpolated random values at integer lattice points. Blocky, cheapest. */
+	Value,
+	/** Classic gradient noise (improved Perlin noise) */
+	Perlin,
+	/** Simplex gradient noise. Fewer directional artifacts than Perlin, and cheaper in 3D. */
+	Simplex,
+};
+
+// The result of timing and measuring one fast approximation against its libm equivalent, see BenchmarkFastMath
+USTRUCT(BlueprintType)
+struct FRyFastMathBenchmarkResult
+{
+	GENERATED_BODY()
+
+	/** The function measured */
+	UPROPERTY(BlueprintReadOnly, Category = FastMath)
+	FString Function;
+
+	/** Average milliseconds per pass calling the libm (or FMath) version per element */
+	UPROPERTY(BlueprintReadOnly, Category = FastMath)
+	float LibmMilliseconds;
+
+	/** Average milliseconds per pass calling the fast scalar version per element */
+	UPROPERTY(BlueprintReadOnly, Category = FastMath)
+	float FastMilliseconds;
+
+	/** Average milliseconds per pass calling the fast batch version once */
+	UPROPERTY(BlueprintReadOnly, Category = FastMath)
+	float FastBatchMilliseconds;
+
+	/** Largest absolute difference of the fast batch result from the double precision result */
+	UPROPERTY(BlueprintReadOnly, Category = FastMath)
+	float MaxAbsoluteError;
+
+	/** Largest relative difference of the fast batch result from the double precision result */
+	UPROPERTY(BlueprintReadOnly, Category = FastMath)
+	float MaxRelativeError;
+
+	FRyFastMathBenchmarkResult()
+		: LibmMilliseconds(0.0f)
+		, FastMilliseconds(0.0f)
+		, FastBatchMilliseconds(0.0f)
+		, MaxAbsoluteError(0.0f)
+		, MaxRelativeError(0.0f)
+	{
+	}
+};
+
+// Polynomial coefficients shared by the scalar and SIMD fast approximations, so their results are equivalent within the
+// stated error bounds (they can differ in the last bit where one path contracts to FMA and the other doesn't).
+// Fitted as minimax polynomials over the reduced ranges noted.
+namespace RyFastMath
+{
+	// 2^f, f in [0, 1)
+	constexpr float Exp2C0 = 0.9999999251f;
+	constexpr float Exp2C1 = 0.6931530730f;
+	constexpr float Exp2C2 = 0.2401536182f;
+	constexpr float Exp2C3 = 0.0558263156f;
+	constexpr float Exp2C4 = 0.0089893423f;
+	constexpr float Exp2C5 = 0.0018775760f;
+
+	// sin(x) and cos(x), x in [-PI/2, PI/2]
+	constexpr float SinC1 = 0.99999661584f;
+	constexpr float SinC3 = -0.16664828355f;
+	constexpr float SinC5 = 0.0083063249712f;
+	constexpr float SinC7 = -0.00018363647138f;
+	constexpr float CosC0 = 0.9999932951f;
+	constexpr float CosC2 = -0.4999124382f;
+	constexpr float CosC4 = 0.0414877461f;
+	constexpr float CosC6 = -0.0012712089f;
+
+	// atan(x), x in [0, 1]
+	constexpr float AtanC1 = 0.9999772175f;
+	constexpr float AtanC3 = -0.3326227928f;
+	constexpr float AtanC5 = 0.1935401673f;
+	constexpr float AtanC7 = -0.1164259797f;
+	constexpr float AtanC9 = 0.0526468259f;
+	constexpr float AtanC11 = -0.0117189367f;
+
+	// ln(2) split in two so exp range reduction keeps precision (Cody-Waite). Hi has few mantissa bits, so n * Hi is exact.
+	constexpr float Log2E = 1.44269504f;
+	constexpr float Ln2Hi = 0.693359375f;
+	constexpr float Ln2Lo = -2.12194440e-4f;
+
+	// 2 * PI split in two so range reduction keeps precision (Cody-Waite)
+	constexpr float TwoPiHi = 6.28125f;
+	constexpr float TwoPiLo = 0.0019353071693331f;
+
+	// Exp input is clamped to this range to keep the result a normal float
+	constexpr float ExpMin = -87.0f;
+	constexpr float ExpMax = 88.0f;
+
+	// Below this magnitude SinH uses its Taylor series to avoid cancellation in (e^x - e^-x) / 2
+	constexpr float SinHSeriesLimit = 0.5f;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 /**
   * Static Helper functions for mathematics.
@@ -76,6 +277,87 @@ public:
 	UFUNCTION(BlueprintPure, meta=(DisplayName = "CosH (Radians)", CompactNodeTitle = "COSH"), Category="RyRuntime|Math|Trig")
 	static float CosH(float A);
 
+	/**
+	 * The Fast* functions are opt-in polynomial approximations for bulk, visual only work where speed matters more
+	 * than the last few bits of precision. Maximum errors below were measured against double precision over the
+	 * documented input ranges. The batch forms process 4 values at a time with SIMD and give results equivalent within
+	 * the stated bounds. The bounds are asserted by the Ry.Runtime.Math.FastMathErrorBounds automation test.
+	 * See BenchmarkFastMath.
+	 */
+
+	/** Fast approximation of e^A. Max relative error 2.5e-7. A is clamped to [-87, 88]. */
+	UFUNCTION(BlueprintPure, meta=(DisplayName = "Fast Exp"), Category="RyRuntime|Math|Fast")
+	static float FastExp(float A);
+
+	/** Fast approximation of SinH. Max relative error 4.5e-7 (sinhf is about 1.2e-7). A is clamped to [-87, 88]. */
+	UFUNCTION(BlueprintPure, meta=(DisplayName = "Fast SinH (Radians)"), Category="RyRuntime|Math|Fast")
+	static float FastSinH(float A);
+
+	/** Fast approximation of CosH. Max relative error 3.5e-7 (coshf is about 1.2e-7). A is clamped to [-87, 88]. */
+	UFUNCTION(BlueprintPure, meta=(DisplayName = "Fast CosH (Radians)"), Category="RyRuntime|Math|Fast")
+	static float FastCosH(float A);
+
+	/** Fast approximation of sin and cos together. Max absolute error 8e-7 (sin) and 7e-6 (cos) for |A| <= 1000. */
+	UFUNCTION(BlueprintPure, meta=(DisplayName = "Fast SinCos (Radians)"), Category="RyRuntime|Math|Fast")
+	static void FastSinCos(float A, float& sinOut, float& cosOut);
+
+	/** Fast approximation of Sin. Max absolute error 8e-7 for |A| <= 1000. */
+	UFUNCTION(BlueprintPure, meta=(DisplayName = "Fast Sin (Radians)"), Category="RyRuntime|Math|Fast")
+	static float FastSin(float A);
+
+	/** Fast approximation of Cos. Max absolute error 7e-6 for |A| <= 1000. */
+	UFUNCTION(BlueprintPure, meta=(DisplayName = "Fast Cos (Radians)"), Category="RyRuntime|Math|Fast")
+	static float FastCos(float A);
+
+	/** Fast approximation of Atan2. Max absolute error 2e-6 radians. */
+	UFUNCTION(BlueprintPure, meta=(DisplayName = "Fast Atan2 (Radians)"), Category="RyRuntime|Math|Fast")
+	static float FastAtan2(float Y, float X);
+
+	/**
+	 * CalculateCatenary using FastCosH. Max relative error 3e-7 + 6e-8 * |X / scalingFactor|, the second term being the
+	 * rounding of the division, which CalculateCatenary has too.
+	 */
+	UFUNCTION(BlueprintPure, Category="RyRuntime|Math|Fast")
+	static float FastCalculateCatenary(float X, float scalingFactor);
+
+	/** Array version of FastSinH. valuesOut may be the same array as values. */
+	UFUNCTION(BlueprintPure, Category="RyRuntime|Math|Fast")
+	static void FastSinHArray(const TArray<float>& values, TArray<float>& valuesOut);
+
+	/** Array version of FastCosH. valuesOut may be the same array as values. */
+	UFUNCTION(BlueprintPure, Category="RyRuntime|Math|Fast")
+	static void FastCosHArray(const TArray<float>& values, TArray<float>& valuesOut);
+
+	/** Array version of FastSinCos */
+	UFUNCTION(BlueprintPure, Category="RyRuntime|Math|Fast")
+	static void FastSinCosArray(const TArray<float>& angles, TArray<float>& sinsOut, TArray<float>& cossOut);
+
+	/** Array version of FastAtan2. ys and xs must be the same length. */
+	UFUNCTION(BlueprintPure, Category="RyRuntime|Math|Fast")
+	static void FastAtan2Array(const TArray<float>& ys, const TArray<float>& xs, TArray<float>& anglesOut);
+
+	/** Array version of FastCalculateCatenary, all at the same scaling factor */
+	UFUNCTION(BlueprintPure, Category="RyRuntime|Math|Fast")
+	static void FastCalculateCatenaryArray(const TArray<float>& xs, const float scalingFactor, TArray<float>& valuesOut);
+
+	/**
+	 * Native kernels behind the Fast*Array functions.
+	 * All pointers must reference at least 'num' elements. Input and output arrays may alias.
+	 */
+	static void FastSinHBatch(const float* values, float* valuesOut, const int32 num);
+	static void FastCosHBatch(const float* values, float* valuesOut, const int32 num);
+	static void FastSinCosBatch(const float* angles, float* sinsOut, float* cossOut, const int32 num);
+	static void FastAtan2Batch(const float* ys, const float* xs, float* anglesOut, const int32 num);
+	static void FastCalculateCatenaryBatch(const float* xs, const float scalingFactor, float* valuesOut, const int32 num);
+
+	/**
+	 * Accuracy and throughput suite for the Fast* functions. For each function, times the libm version, the fast
+	 * scalar version and the fast batch version over numElements random inputs, and measures the batch results
+	 * against double precision. Results are also logged.
+	 */
+	UFUNCTION(BlueprintCallable, Category="RyRuntime|Math|Fast", meta=(DevelopmentOnly))
+	static void BenchmarkFastMath(const int32 numElements, const int32 iterations, TArray<FRyFastMathBenchmarkResult>& results);
+
     /** 
      Calculates the catenary of X at a specific scaling factor
      The scaling factor may be thought of as the ratio between the horizontal tension on the cable and the weight 
@@ -84,12 +366,69 @@ public:
     UFUNCTION(BlueprintPure, Category = "Math|Utility")
     static float CalculateCatenary(float X, float scalingFactor);
 
+	/**
+	 * Solve for the catenary scaling factor of a cable hanging under gravity.
+	 * Uses Newton iteration on sinh(u) / u = sqrt(length^2 - verticalDistance^2) / horizontalDistance.
+	 * @param horizontalDistance - Distance between the cable ends, perpendicular to gravity
+	 * @param verticalDistance - Height difference between the cable ends
+	 * @param length - Length of the cable
+	 * @return The scaling factor, or zero if the cable is too short to sag (taut) or hangs straight down
+	 */
+	UFUNCTION(BlueprintPure, Category = "Math|Utility")
+	static float SolveCatenaryScalingFactor(const float horizontalDistance, const float verticalDistance, const float length);
+
+	/**
+	 * Solve a cable of length hanging (along -Z) between start and end into a polyline of numPoints points.
+	 * Taut cables produce a straight line.
+	 * @param pointsOut - The world space points of the cable, from start to end
+	 * @param scalingFactor - The solved scaling factor, see CalculateCatenary
+	 */
+	UFUNCTION(BlueprintPure, Category = "Math|Utility", meta=(AdvancedDisplay = "3"))
+	static void CalculateCatenaryPolyline(const FVector& start, const FVector& end, const float length, TArray<FVector>& pointsOut,
+	                                      float& scalingFactor, const int32 numPoints = 16);
+
+	/**
+	 * Solve a cable into its Points, if the cable has changed since it was last solved.
+	 * @param force - Solve even if the cable doesn't appear to have changed
+	 * @return True if the cable was solved, false if the cached points were still valid
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Math|Utility", meta=(AdvancedDisplay = "1"))
+	static bool SolveCatenaryCable(UPARAM(ref) FRyCatenaryCable& cable, const bool force = false);
+
+	/**
+	 * Solve many cables at once. Only cables which have changed since they were last solved are solved.
+	 * @param force - Solve every cable even if it doesn't appear to have changed
+	 * @return The number of cables which were solved
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Math|Utility", meta=(AdvancedDisplay = "1"))
+	static int32 SolveCatenaryCables(UPARAM(ref) TArray<FRyCatenaryCable>& cables, const bool force = false);
+
 	/**
 	 * Convert a unit value to another unit value
 	 */
 	UFUNCTION(BlueprintPure, Category = "Math|Utility")
 	static float ConvertUnit(const float value, const ERyUnit from, const ERyUnit to);
 
+	/**
+	 * Resolve a unit conversion once so it can be applied to many values cheaply.
+	 * See ConvertUnitWithPlan and ConvertUnitArray.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Math|Utility")
+	static FRyUnitConversionPlan MakeUnitConversionPlan(const ERyUnit from, const ERyUnit to);
+
+	/**
+	 * Convert a unit value using a plan made with MakeUnitConversionPlan
+	 */
+	UFUNCTION(BlueprintPure, Category = "Math|Utility")
+	static float ConvertUnitWithPlan(const float value, const FRyUnitConversionPlan& plan);
+
+	/**
+	 * Convert an array of unit values using a plan made with MakeUnitConversionPlan. Processes 4 values at a time with SIMD.
+	 * @param valuesOut - The converted values, aligned to values. May be the same array as values.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Math|Utility")
+	static void ConvertUnitArray(const TArray<float>& values, const FRyUnitConversionPlan& plan, TArray<float>& valuesOut);
+
 	/**
 	 * Takes a startRotation and finds the shortest path to endRotation.
 	 * Input rotations are clamped, and output rotation is clamped. [0-360]
@@ -124,6 +463,40 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Math|Rotations", meta=(AdvancedDisplay = "6"))
 	static void RotationInterpolate(const float inCurrent, const float inTarget, const float deltaTime, const float speed, float& newRotation, bool& atTarget, const float checkTolerance = 1.e-6f);
 
+	/**
+	 * Array version of ShortestRotationPath. Processes 4 rotations at a time with SIMD.
+	 * startRotations and endRotations must be the same length.
+	 * @param pathsOut - The shortest path for each start / end pair, aligned to startRotations
+	 */
+	UFUNCTION(BlueprintPure, Category = "Math|Rotations")
+	static void ShortestRotationPathArray(const TArray<float>& startRotations, const TArray<float>& endRotations, TArray<float>& pathsOut);
+
+	/**
+	 * Array version of RotationInterpolate. Processes 4 rotations at a time with SIMD.
+	 * Results match RotationInterpolate within floating point tolerance.
+	 * currents, targets and speeds must be the same length.
+	 * @param newRotations - The new rotations, aligned to currents
+	 * @param atTargets - True per rotation if the target was reached, aligned to currents
+	 */
+	UFUNCTION(BlueprintPure, Category = "Math|Rotations", meta=(AdvancedDisplay = "6"))
+	static void RotationInterpolateArray(const TArray<float>& currents, const TArray<float>& targets, const float deltaTime, const TArray<float>& speeds,
+	                                     TArray<float>& newRotations, TArray<bool>& atTargets, const float checkTolerance = 1.e-6f);
+
+	/**
+	 * Native structure of arrays kernels behind ShortestRotationPathArray and RotationInterpolateArray.
+	 * All pointers must reference at least 'num' elements. Input and output arrays may alias.
+	 */
+	static void ShortestRotationPathBatch(const float* startRotations, const float* endRotations, float* pathsOut, const int32 num);
+	static void RotationInterpolateBatch(const float* currents, const float* targets, const float* speeds, const float deltaTime,
+	                                     const float checkTolerance, float* newRotations, bool* atTargets, const int32 num);
+
+	/**
+	 * Times RotationInterpolate called per element against RotationInterpolateArray over numElements random rotations.
+	 * Returns the average milliseconds per pass for each path, and the largest angular difference between their results.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Math|Rotations", meta=(DevelopmentOnly))
+	static void BenchmarkRotationInterpolate(const int32 numElements, const int32 iterations, float& scalarMilliseconds, float& batchMilliseconds, float& maxError);
+
 	// Returns inFloat as a negative value, even if inFloat is already negative.
 	UFUNCTION(BlueprintPure, Category = "Math|Float", meta=(DisplayName = "Negate", CompactNodeTitle = "NEG"))
 	static float MakeNegative(const float inFloat);
@@ -140,6 +513,98 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Math|Float", meta=(DisplayName = "PositiveInline", CompactNodeTitle = "POS"))
     static void MakePositiveInline(UPARAM(ref) float& inFloat);
 
+	// Returns the sum of all values. Zero if empty. Processes 4 values at a time with SIMD.
+	UFUNCTION(BlueprintPure, Category = "Math|Float|Array")
+	static float SumFloatArray(const TArray<float>& values);
+
+	// Returns the smallest value and its index (the first, if there are several). Zero and IndexNone if empty.
+	UFUNCTION(BlueprintPure, Category = "Math|Float|Array")
+	static float MinFloatArray(const TArray<float>& values, int32& minIndex);
+
+	// Returns the largest value and its index (the first, if there are several). Zero and IndexNone if empty.
+	UFUNCTION(BlueprintPure, Category = "Math|Float|Array")
+	static float MaxFloatArray(const TArray<float>& values, int32& maxIndex);
+
+	// Returns the mean (average) of all values. Zero if empty.
+	UFUNCTION(BlueprintPure, Category = "Math|Float|Array")
+	static float MeanFloatArray(const TArray<float>& values);
+
+	// Returns the variance of all values, and their mean. Zero if empty.
+	// @param sample - Return the sample variance (divide by N - 1) instead of the population variance (divide by N)
+	UFUNCTION(BlueprintPure, Category = "Math|Float|Array", meta=(AdvancedDisplay = "2"))
+	static float VarianceFloatArray(const TArray<float>& values, float& mean, const bool sample = false);
+
+	// Multiplies every value by scale, in place
+	UFUNCTION(BlueprintCallable, Category = "Math|Float|Array")
+	static void ScaleFloatArrayInline(UPARAM(ref) TArray<float>& values, const float scale);
+
+	// Adds offset to every value, in place
+	UFUNCTION(BlueprintCallable, Category = "Math|Float|Array")
+	static void OffsetFloatArrayInline(UPARAM(ref) TArray<float>& values, const float offset);
+
+	// Clamps every value to [min, max], in place
+	UFUNCTION(BlueprintCallable, Category = "Math|Float|Array")
+	static void ClampFloatArrayInline(UPARAM(ref) TArray<float>& values, const float min, const float max);
+
+	// Linearly interpolates every value towards the matching value of targets by alpha, in place. values and targets must be the same length.
+	UFUNCTION(BlueprintCallable, Category = "Math|Float|Array")
+	static void LerpFloatArrayInline(UPARAM(ref) TArray<float>& values, const TArray<float>& targets, const float alpha);
+
+	// Remaps every value from [min value, max value] to [0, 1], in place. If every value is the same they all become 0.
+	UFUNCTION(BlueprintCallable, Category = "Math|Float|Array")
+	static void NormalizeFloatArrayInline(UPARAM(ref) TArray<float>& values);
+
+	/**
+	 * Sorts by key without moving anything: returns the permutation of indices which orders keys.
+	 * Use it to visit (or rebuild) any array aligned to keys in sorted order e.g. actors by distance.
+	 * Radix sort, so the sort is linear in the number of keys and stable (equal keys keep their original order).
+	 * -0 sorts before +0, and NaNs sort to the ends (past the infinity of the same sign).
+	 * @param sortedIndices - Indices into keys, ordered so keys[sortedIndices[0]] is the smallest (largest if descending)
+	 */
+	UFUNCTION(BlueprintPure, Category = "Math|Sort", meta=(AdvancedDisplay = "2"))
+	static void SortIndicesByFloatKeys(const TArray<float>& keys, TArray<int32>& sortedIndices, const bool descending = false);
+
+	/** See SortIndicesByFloatKeys */
+	UFUNCTION(BlueprintPure, Category = "Math|Sort", meta=(AdvancedDisplay = "2"))
+	static void SortIndicesByIntKeys(const TArray<int32>& keys, TArray<int32>& sortedIndices, const bool descending = false);
+
+	/**
+	 * Partial version of SortIndicesByFloatKeys which only returns the indices of the k smallest (largest if descending)
+	 * keys, in sorted order. Selects the k keys with a linear radix select before sorting only those, so picking the
+	 * best few of many candidates costs little more than a pass over the keys. Stable, like SortIndicesByFloatKeys.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Math|Sort", meta=(AdvancedDisplay = "3"))
+	static void TopKIndicesByFloatKeys(const TArray<float>& keys, const int32 k, TArray<int32>& sortedIndices, const bool descending = false);
+
+	/** See TopKIndicesByFloatKeys */
+	UFUNCTION(BlueprintPure, Category = "Math|Sort", meta=(AdvancedDisplay = "3"))
+	static void TopKIndicesByIntKeys(const TArray<int32>& keys, const int32 k, TArray<int32>& sortedIndices, const bool descending = false);
+
+	/**
+	 * Sample noise at a single position. Results are roughly in [-1, 1] and repeat exactly for the same seed.
+	 * For many samples use FillNoiseGrid.
+	 * @param numDimensions - 1 samples along X, 2 on the XY plane, 3 in XYZ
+	 */
+	UFUNCTION(BlueprintPure, Category = "Math|Noise", meta=(AdvancedDisplay = "3"))
+	static float SampleNoise(const ERyNoiseType noiseType, const FVector& position, const int32 seed = 0, const int32 numDimensions = 3);
+
+	/**
+	 * Fill valuesOut with noise sampled over a regular 1D, 2D or 3D grid in one call. Results are roughly in [-1, 1].
+	 * Samples are computed 4 at a time with SIMD, and large grids are split across task graph workers.
+	 * Each sample equals SampleNoise at its position, within float rounding of the position.
+	 * @param gridSize - Number of samples along each axis
+	 * @param origin - Noise space position of the first sample
+	 * @param sampleSpacing - Noise space distance between neighbouring samples along each axis (acts as frequency)
+	 * @param valuesOut - Sample (x, y, z) is at index x + gridSize.X * (y + gridSize.Y * z)
+	 * @param numDimensions - 1 samples along X, 2 on the XY plane, 3 in XYZ, as for SampleNoise. Independent of gridSize, so
+	 *                        a one row strip or one slice of a larger field matches the full field. Axes past numDimensions
+	 *                        are ignored by the noise.
+	 * @param allowParallel - Allow large grids to be filled on multiple threads
+	 */
+	UFUNCTION(BlueprintPure, Category = "Math|Noise", meta=(AdvancedDisplay = "5"))
+	static void FillNoiseGrid(const ERyNoiseType noiseType, const FIntVector& gridSize, const FVector& origin, const FVector& sampleSpacing,
+	                          TArray<float>& valuesOut, const int32 seed = 0, const int32 numDimensions = 3, const bool allowParallel = true);
+
 	// A constant used by the engine denoting an invalid index.
 	// Array Find operations return IndexNone if an element could not be found.
 	// Most returned indices are IndexNone if invalid.
@@ -160,6 +625,20 @@ public:
 	UFUNCTION(BlueprintCallable, meta = (WorldContext = "WorldContextObject", CallableWithoutWorldContext), Category = "RyRuntime|Math|HUD")
 	static void FindScreenEdgeLocationForWorldLocation(UObject* WorldContextObject, const FVector& InLocation, const float EdgePercent, FVector2D& OutScreenPosition, float& OutRotationAngleDegrees, bool &bIsOnScreen);
 
+	/**
+	* Batch version of FindScreenEdgeLocationForWorldLocation for HUDs with many markers.
+	* The viewport, player and view projection are resolved once and every location is projected against them.
+	*
+	* @param		InLocations	- The world space locations to be converted to screen space
+	* @param		EdgePercent - How close to the edge of the screen, 1.0 = at edge, 0.0 = at center of screen. .9 or .95 is usually desirable
+	* @outparam	OutScreenPositions - the screen coordinates for HUD drawing, aligned to InLocations
+	* @outparam	OutRotationAnglesDegrees - The angles to rotate hud elements pointing toward offscreen indicators, aligned to InLocations
+	* @outparam	OutIsOnScreen - True per location if it is in the camera view (may be obstructed), aligned to InLocations
+	*/
+	UFUNCTION(BlueprintCallable, meta = (WorldContext = "WorldContextObject", CallableWithoutWorldContext), Category = "RyRuntime|Math|HUD")
+	static void FindScreenEdgeLocationsForWorldLocations(UObject* WorldContextObject, const TArray<FVector>& InLocations, const float EdgePercent,
+	                                                     TArray<FVector2D>& OutScreenPositions, TArray<float>& OutRotationAnglesDegrees, TArray<bool>& OutIsOnScreen);
+
 	// With TheSize of the surface ex (800 x 600) and TheAngle from the center of the surface, what is the point on TheSize where TheAngle would hit?
 	UFUNCTION(BlueprintCallable, Category = "RyRuntime|Math|HUD")
 	static FVector2D FindEdgeOf2DSquare(const FVector2D &TheSize, const float TheAngle);
@@ -227,6 +706,26 @@ public:
 	/** Rotate the world up vector by the given rotation, excluding the Z axis */
 	UFUNCTION(BlueprintPure, meta=(DisplayName = "Get Up Vector 2D", ScriptMethod = "GetUpVector2D", Keywords="rotation rotate"), Category="RyRuntime|Math|Vector")
     static FVector GetUpVector2D(FRotator InRot);
+
+	/** Returns the 2D dot product of every vector in Vectors with Reference, Z axis excluded. Processes 4 vectors at a time with SIMD. */
+	UFUNCTION(BlueprintPure, meta=(DisplayName = "Dot Product 2D (Array)"), Category="RyRuntime|Math|Vector")
+	static void Dot_VectorArray2D(const TArray<FVector>& Vectors, const FVector& Reference, TArray<float>& DotProductsOut);
+
+	/** Returns the 2D squared distance from every point in Points to Reference, Z axis excluded. Processes 4 points at a time with SIMD. */
+	UFUNCTION(BlueprintPure, meta=(DisplayName = "Distance Squared 2D (Array)"), Category="RyRuntime|Math|Vector")
+	static void DistanceSquared_VectorArray2D(const TArray<FVector>& Points, const FVector& Reference, TArray<float>& DistancesSquaredOut);
+
+	/**
+	 * Finds the point in Points nearest to Reference, Z axis excluded. Processes 4 points at a time with SIMD.
+	 * @param DistanceSquaredOut - The 2D squared distance to the nearest point
+	 * @return The index of the nearest point, or IndexNone if Points is empty. On ties the lowest index wins.
+	 */
+	UFUNCTION(BlueprintPure, meta=(DisplayName = "Find Nearest Point 2D"), Category="RyRuntime|Math|Vector")
+	static int32 FindNearestPoint2D(const TArray<FVector>& Points, const FVector& Reference, float& DistanceSquaredOut);
+
+	/** Array version of GetForwardVector2D. Processes 4 rotations at a time with SIMD. */
+	UFUNCTION(BlueprintPure, meta=(DisplayName = "Get Forward Vectors 2D (Array)", Keywords="rotation rotate"), Category="RyRuntime|Math|Vector")
+	static void GetForwardVectors2D(const TArray<FRotator>& InRots, TArray<FVector>& ForwardVectorsOut);
 };
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -256,6 +755,129 @@ float URyRuntimeMathHelpers::CalculateCatenary(float X, float scalingFactor)
     return scalingFactor * coshf(X / scalingFactor);
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+FORCEINLINE
+float URyRuntimeMathHelpers::FastExp(float A)
+{
+	// e^A = 2^(A * log2(e)) = 2^n * 2^f, with n an integer and f in [0, 1)
+	// f is found from A - n * ln(2) rather than from A * log2(e), whose rounding would scale with |A|
+	const float clamped = FMath::Clamp(A, RyFastMath::ExpMin, RyFastMath::ExpMax);
+	const float n = FMath::FloorToFloat(clamped * RyFastMath::Log2E);
+	const float f = ((clamped - n * RyFastMath::Ln2Hi) - n * RyFastMath::Ln2Lo) * RyFastMath::Log2E;
+	const float p = RyFastMath::Exp2C0 + f * (RyFastMath::Exp2C1 + f * (RyFastMath::Exp2C2 + f * (RyFastMath::Exp2C3 + f * (RyFastMath::Exp2C4 + f * RyFastMath::Exp2C5))));
+
+	// Build 2^n directly in the float exponent bits
+	const uint32 scaleBits = static_cast<uint32>(static_cast<int32>(n) + 127) << 23;
+	float scale;
+	FMemory::Memcpy(&scale, &scaleBits, sizeof(float));
+	return p * scale;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+FORCEINLINE
+float URyRuntimeMathHelpers::FastSinH(float A)
+{
+	if(FMath::Abs(A) < RyFastMath::SinHSeriesLimit)
+	{
+		const float a2 = A * A;
+		return A * (1.0f + a2 * (1.0f / 6.0f + a2 * (1.0f / 120.0f + a2 * (1.0f / 5040.0f))));
+	}
+	const float e = FastExp(A);
+	return 0.5f * (e - 1.0f / e);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+FORCEINLINE
+float URyRuntimeMathHelpers::FastCosH(float A)
+{
+	const float e = FastExp(A);
+	return 0.5f * (e + 1.0f / e);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+FORCEINLINE
+void URyRuntimeMathHelpers::FastSinCos(float A, float& sinOut, float& cosOut)
+{
+	// Reduce to [-PI, PI]
+	float quotient = A * (0.5f / PI);
+	quotient = static_cast<float>(static_cast<int32>(quotient + (quotient >= 0.0f ? 0.5f : -0.5f)));
+	float y = (A - quotient * RyFastMath::TwoPiHi) - quotient * RyFastMath::TwoPiLo;
+
+	// Reflect to [-PI/2, PI/2], where cos changes sign
+	float sign = 1.0f;
+	if(y > HALF_PI)
+	{
+		y = PI - y;
+		sign = -1.0f;
+	}
+	else if(y < -HALF_PI)
+	{
+		y = -PI - y;
+		sign = -1.0f;
+	}
+
+	const float y2 = y * y;
+	sinOut = y * (RyFastMath::SinC1 + y2 * (RyFastMath::SinC3 + y2 * (RyFastMath::SinC5 + y2 * RyFastMath::SinC7)));
+	cosOut = sign * (RyFastMath::CosC0 + y2 * (RyFastMath::CosC2 + y2 * (RyFastMath::CosC4 + y2 * RyFastMath::CosC6)));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+FORCEINLINE
+float URyRuntimeMathHelpers::FastSin(float A)
+{
+	float s, c;
+	FastSinCos(A, s, c);
+	return s;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+FORCEINLINE
+float URyRuntimeMathHelpers::FastCos(float A)
+{
+	float s, c;
+	FastSinCos(A, s, c);
+	return c;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+FORCEINLINE
+float URyRuntimeMathHelpers::FastAtan2(float Y, float X)
+{
+	// atan of the smaller over the larger magnitude is in [0, PI/4], then unfold by octant
+	const float absX = FMath::Abs(X);
+	const float absY = FMath::Abs(Y);
+	const float maxXY = FMath::Max(absX, absY);
+	const float z = maxXY > 0.0f ? FMath::Min(absX, absY) / maxXY : 0.0f;
+	const float z2 = z * z;
+	float result = z * (RyFastMath::AtanC1 + z2 * (RyFastMath::AtanC3 + z2 * (RyFastMath::AtanC5 + z2 * (RyFastMath::AtanC7 + z2 * (RyFastMath::AtanC9 + z2 * RyFastMath::AtanC11)))));
+	result = absY > absX ? HALF_PI - result : result;
+	result = X < 0.0f ? PI - result : result;
+	return Y < 0.0f ? -result : result;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+FORCEINLINE
+float URyRuntimeMathHelpers::FastCalculateCatenary(float X, float scalingFactor)
+{
+	return scalingFactor * FastCosH(X / scalingFactor);
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 /**
 */
@@ -265,6 +887,15 @@ float URyRuntimeMathHelpers::ConvertUnit(const float value, const ERyUnit from,
 	return FUnitConversion::Convert<float>(value, static_cast<EUnit>(from), static_cast<EUnit>(to));
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+*/
+FORCEINLINE
+float URyRuntimeMathHelpers::ConvertUnitWithPlan(const float value, const FRyUnitConversionPlan& plan)
+{
+	return plan.Convert(value);
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 /**
 */
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "Modules/ModuleManager.h"
+#include "Stats/Stats.h"
 
 //---------------------------------------------------------------------------------------------------------------------
 /**
@@ -18,3 +19,6 @@ public:
 };
 
 DECLARE_LOG_CATEGORY_EXTERN(LogRyRuntime, Log, All);
+
+// Stat group for profiling RyRuntime systems, view in game with "stat RyRuntime"
+DECLARE_STATS_GROUP(TEXT("RyRuntime"), STATGROUP_RyRuntime, STATCAT_Advanced);
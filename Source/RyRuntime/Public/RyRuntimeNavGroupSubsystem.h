@@ -0,0 +1,85 @@
+// Copyright 2020-2021 Sheffer Online Services.
+// MIT License. See LICENSE for details.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "RyRuntimeNavGroupSubsystem.generated.h"
+
+class ANavLinkProxy;
+class UNavArea;
+class UNavModifierComponent;
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+  * A world subsystem which keeps named groups of nav link proxies and nav modifier components (doors, bridges...), so a
+  * whole group can be enabled, disabled or moved to another nav area in one call.
+  * Enabling or disabling sets the navigation relevancy of the smart links and modifiers. Nav link proxy updates go through
+  * one URyRuntimeNavUpdateSubsystem batch, so each proxy is updated once per call. The smart link and modifier components
+  * still notify the navigation system once each, as soon as their relevancy changes.
+  * Groups hold weak references, destroyed members drop out on their own.
+*/
+UCLASS()
+class RYRUNTIME_API URyRuntimeNavGroupSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+public:
+
+    /** USubsystem implementation */
+    virtual void Deinitialize() override;
+
+    // Add a nav link proxy to a group, creating the group if needed. Returns false if already in the group.
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|NavigationHelpers|NavGroup")
+    bool AddNavLinkToGroup(const FName groupName, ANavLinkProxy* navLinkProxy);
+
+    // Add a nav modifier component to a group, creating the group if needed. Returns false if already in the group.
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|NavigationHelpers|NavGroup")
+    bool AddNavModifierToGroup(const FName groupName, UNavModifierComponent* navModifier);
+
+    // Add every nav link proxy with actorTag, and every nav modifier on actors with actorTag, to a group.
+    // Returns the number of links and modifiers added.
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|NavigationHelpers|NavGroup")
+    int32 AddActorsWithTagToNavGroup(const FName groupName, const FName actorTag);
+
+    // Remove a nav link proxy or nav modifier component from a group. Returns false if it wasn't in the group.
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|NavigationHelpers|NavGroup")
+    bool RemoveFromNavGroup(const FName groupName, UObject* member);
+
+    // Forget a group. Its members are left as they are.
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|NavigationHelpers|NavGroup")
+    void RemoveNavGroup(const FName groupName);
+
+    // Enable or disable every member of a group by setting the navigation relevancy of its smart links and modifiers.
+    // Returns the number of members changed.
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|NavigationHelpers|NavGroup")
+    int32 SetNavGroupEnabled(const FName groupName, const bool enabled);
+
+    // Move every member of a group to another nav area: the enabled area of links, and the area of modifiers.
+    // Not batched, each changed link or modifier updates the navigation system as it is set.
+    // Returns the number of members updated.
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|NavigationHelpers|NavGroup")
+    int32 SetNavGroupAreaClass(const FName groupName, TSubclassOf<UNavArea> areaClass);
+
+    // Get the live members of a group
+    UFUNCTION(BlueprintPure, Category = "RyRuntime|NavigationHelpers|NavGroup")
+    void GetNavGroupMembers(const FName groupName, TArray<ANavLinkProxy*>& navLinksOut, TArray<UNavModifierComponent*>& navModifiersOut) const;
+
+    UFUNCTION(BlueprintPure, Category = "RyRuntime|NavigationHelpers|NavGroup")
+    bool HasNavGroup(const FName groupName) const { return Groups.Contains(groupName); }
+
+    UFUNCTION(BlueprintPure, Category = "RyRuntime|NavigationHelpers|NavGroup")
+    void GetNavGroupNames(TArray<FName>& groupNamesOut) const { Groups.GetKeys(groupNamesOut); }
+
+private:
+
+    struct FNavGroup
+    {
+        TArray<TWeakObjectPtr<ANavLinkProxy>> NavLinks;
+        TArray<TWeakObjectPtr<UNavModifierComponent>> NavModifiers;
+
+        // Drop members which have been destroyed
+        void RemoveStale();
+    };
+
+    TMap<FName, FNavGroup> Groups;
+};
@@ -0,0 +1,118 @@
+// Copyright 2020-2021 Sheffer Online Services.
+// MIT License. See LICENSE for details.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
+#include "RyRuntimeNavUpdateSubsystem.generated.h"
+
+// Counters of nav octree update batching, totals are since the world started or stats were reset
+USTRUCT(BlueprintType)
+struct RYRUNTIME_API FRyNavUpdateStats
+{
+    GENERATED_BODY()
+
+    // Updates asked for by RequestNavOctreeUpdate
+    UPROPERTY(BlueprintReadOnly, Category = "RyRuntime|NavigationHelpers")
+    int32 NumRequested = 0;
+
+    // Octree updates actually issued to the navigation system
+    UPROPERTY(BlueprintReadOnly, Category = "RyRuntime|NavigationHelpers")
+    int32 NumIssued = 0;
+
+    // Requests folded into another update of the same actor. Only actor updates are counted, component updates the
+    // engine issues directly (e.g. from SetNavigationRelevancy) never reach the subsystem.
+    UPROPERTY(BlueprintReadOnly, Category = "RyRuntime|NavigationHelpers")
+    int32 NumCoalesced = 0;
+
+    // Number of flushes which issued at least one update
+    UPROPERTY(BlueprintReadOnly, Category = "RyRuntime|NavigationHelpers")
+    int32 NumFlushes = 0;
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+  * A world subsystem which collects actors needing a nav octree update, and updates each once when flushed, rather
+  * than once per edit. URyRuntimeNavigationHelpers smart link edits send their proxy updates through it. Component level
+  * updates the engine makes itself, like a smart link component changing relevancy, are not seen or batched.
+  * In game worlds requests are deferred to the end of the frame (after actors tick). Elsewhere, like editor worlds,
+  * they are issued immediately unless a batch is open.
+  * Batches (BeginNavOctreeUpdateBatch/EndNavOctreeUpdateBatch, or FRyScopedNavOctreeUpdateBatch natively) defer requests
+  * in any world and flush when the outermost batch ends.
+  * Profile with "stat RyRuntime".
+*/
+UCLASS()
+class RYRUNTIME_API URyRuntimeNavUpdateSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+public:
+
+    /** USubsystem implementation */
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    // Ask for actor to be updated in its world's nav octree, through the subsystem of that world if there is one
+    static void RequestNavOctreeUpdate(AActor* actor);
+
+    // Ask for actor to be updated in the nav octree. Multiple requests before the next flush issue one update.
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|NavigationHelpers")
+    void RequestActorUpdate(AActor* actor);
+
+    // Issue every pending update now
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|NavigationHelpers")
+    void FlushNavOctreeUpdates();
+
+    // Open a batch, deferring updates until the matching EndNavOctreeUpdateBatch. Batches nest.
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|NavigationHelpers")
+    void BeginNavOctreeUpdateBatch() { ++BatchDepth; }
+
+    // Close a batch, flushing if it was the outermost one
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|NavigationHelpers")
+    void EndNavOctreeUpdateBatch();
+
+    // Set whether game world requests wait for the end of the frame. If false they are only deferred inside a batch.
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|NavigationHelpers")
+    void SetDeferToEndOfFrame(const bool deferToEndOfFrame);
+
+    // Returns the number of actors waiting for an update
+    UFUNCTION(BlueprintPure, Category = "RyRuntime|NavigationHelpers")
+    int32 GetNumPendingUpdates() const { return PendingActors.Num(); }
+
+    UFUNCTION(BlueprintPure, Category = "RyRuntime|NavigationHelpers")
+    FRyNavUpdateStats GetNavUpdateStats() const { return Stats; }
+
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|NavigationHelpers")
+    void ResetNavUpdateStats() { Stats = FRyNavUpdateStats(); }
+
+private:
+
+    bool ShouldDefer() const;
+    static void IssueUpdate(AActor& actor);
+
+    void OnWorldPostActorTick(UWorld* world, ELevelTick tickType, float deltaSeconds);
+
+    // Pending actors in request order, and the same set for coalescing
+    TArray<TWeakObjectPtr<AActor>> PendingActors;
+    TSet<TWeakObjectPtr<AActor>> PendingActorSet;
+
+    FRyNavUpdateStats Stats;
+    FDelegateHandle PostActorTickHandle;
+    int32 BatchDepth = 0;
+    bool DeferToEndOfFrame = true;
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+  * Defers nav octree updates in world for the lifetime of the scope, issuing them when the outermost scope ends
+*/
+struct RYRUNTIME_API FRyScopedNavOctreeUpdateBatch
+{
+    UE_NONCOPYABLE(FRyScopedNavOctreeUpdateBatch);
+
+    explicit FRyScopedNavOctreeUpdateBatch(UWorld* world);
+    ~FRyScopedNavOctreeUpdateBatch();
+
+private:
+    TWeakObjectPtr<URyRuntimeNavUpdateSubsystem> Subsystem;
+};
@@ -44,13 +44,22 @@ public:
     static FVector GetEndPoint(class UNavLinkCustomComponent* smartLinkComponent);
 
 	// Set the smart link data (start, end, and direction)
+	// The nav octree update is batched by URyRuntimeNavUpdateSubsystem, so many edits in a frame update each proxy once.
 	UFUNCTION(BlueprintCallable, Category = "RyRuntime|NavigationHelpers|SmartLink")
 	static void SetSmartLinkData(class ANavLinkProxy* navLinkProxy, const FVector& relativeStart, const FVector& relativeEnd, ERyNavLinkDirection direction);
 
     // Set whether the smart link in a nav link proxy is relevant
+    // Only the proxy's nav octree update is batched by URyRuntimeNavUpdateSubsystem. The smart link component's own
+    // relevancy change still updates the nav octree immediately, once per call.
     UFUNCTION(BlueprintCallable, Category = "RyRuntime|NavigationHelpers|SmartLink")
     static void SetSmartLinkIsRelevant(class ANavLinkProxy* navLinkProxy, const bool isRelevant);
 
+    // Set whether the smart links in many nav link proxies are relevant, issuing one proxy nav octree update per proxy
+    // (plus the immediate smart link component update, see SetSmartLinkIsRelevant).
+    // For toggling the same set repeatedly, see URyRuntimeNavGroupSubsystem.
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|NavigationHelpers|SmartLink")
+    static void SetSmartLinksAreRelevant(const TArray<class ANavLinkProxy*>& navLinkProxies, const bool isRelevant);
+
     // Get the smart link component of the nav link proxy
     UFUNCTION(BlueprintPure, Category = "RyRuntime|NavLinkHelpers|SmartLink")
     static UNavLinkCustomComponent* GetSmartLinkComponent(class ANavLinkProxy* navLinkProxy);
@@ -0,0 +1,148 @@
+// Copyright 2020-2021 Sheffer Online Services.
+// MIT License. See LICENSE for details.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "RyRuntimeRotationInterpolatorSubsystem.generated.h"
+
+class USceneComponent;
+
+// The rotation component an interpolator drives on its output component
+UENUM(BlueprintType)
+enum class ERyRotationAxis : uint8
+{
+    Pitch,
+    Yaw,
+    Roll,
+};
+
+// Called every update with the new rotation of a callback driven interpolator
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FRyOnRotationUpdated, const int32, InterpolatorHandle, const float, Rotation);
+
+// Called when an interpolator reaches its target
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FRyOnRotationAtTarget, const int32, InterpolatorHandle, const float, Rotation);
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+  * A world subsystem which advances every registered rotation interpolator in one batched update per frame, instead of
+  * each actor calling RotationInterpolate from its own Tick. Interpolators are kept as structure of arrays so the
+  * update is a single URyRuntimeMathHelpers::RotationInterpolateBatch call.
+  * Each interpolator drives either one rotation axis of a scene component, or a callback.
+  * Rotations follow RotationInterpolate and are clamped to [0, 360].
+  * Profile with "stat RyRuntime".
+*/
+UCLASS()
+class RYRUNTIME_API URyRuntimeRotationInterpolatorSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+    GENERATED_BODY()
+public:
+
+    /** USubsystem implementation */
+    virtual void Deinitialize() override;
+
+    /** FTickableGameObject implementation */
+    virtual void Tick(float DeltaTime) override;
+    virtual ETickableTickType GetTickableTickType() const override;
+    virtual bool IsTickable() const override;
+    virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+    virtual TStatId GetStatId() const override;
+
+    // Register an interpolator which drives one rotation axis of component, starting from the component's current rotation.
+    // Returns a handle for the interpolator, or IndexNone if component is invalid. The interpolator is removed if the component is destroyed.
+    // @param worldSpace - Drive the world rotation of the component instead of its relative rotation
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|RotationInterpolator", meta = (AdvancedDisplay = "4"))
+    int32 RegisterComponentInterpolator(USceneComponent* component, const ERyRotationAxis axis, const float target, const float speed,
+                                        const bool worldSpace = false);
+
+    // Register an interpolator which calls onUpdated with its new rotation every update until it reaches its target.
+    // Returns a handle for the interpolator, or IndexNone if onUpdated isn't bound. The interpolator is removed if its callback target is destroyed.
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|RotationInterpolator")
+    int32 RegisterCallbackInterpolator(const float current, const float target, const float speed, FRyOnRotationUpdated onUpdated);
+
+    // Remove an interpolator. Returns false if the handle isn't registered.
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|RotationInterpolator")
+    bool UnregisterInterpolator(const int32 interpolatorHandle);
+
+    // Remove all interpolators
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|RotationInterpolator")
+    void UnregisterAllInterpolators();
+
+    // Set a new target rotation. The interpolator starts moving again if it was at its previous target.
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|RotationInterpolator")
+    bool SetInterpolatorTarget(const int32 interpolatorHandle, const float target);
+
+    // Set the speed (degrees per second) of an interpolator
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|RotationInterpolator")
+    bool SetInterpolatorSpeed(const int32 interpolatorHandle, const float speed);
+
+    // Snap the current rotation of an interpolator
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|RotationInterpolator")
+    bool SetInterpolatorCurrent(const int32 interpolatorHandle, const float current);
+
+    // Get the current rotation of an interpolator. Returns false if the handle isn't registered.
+    UFUNCTION(BlueprintPure, Category = "RyRuntime|RotationInterpolator")
+    bool GetInterpolatorCurrent(const int32 interpolatorHandle, float& current) const;
+
+    // Returns true if the interpolator is registered and at its target
+    UFUNCTION(BlueprintPure, Category = "RyRuntime|RotationInterpolator")
+    bool IsInterpolatorAtTarget(const int32 interpolatorHandle) const;
+
+    // Returns the number of registered interpolators
+    UFUNCTION(BlueprintPure, Category = "RyRuntime|RotationInterpolator")
+    int32 GetNumInterpolators() const { return Currents.Num(); }
+
+    // Set the tolerance used to decide an interpolator has reached its target
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|RotationInterpolator")
+    void SetCheckTolerance(const float checkTolerance) { CheckTolerance = checkTolerance; }
+
+    // Called once each time an interpolator reaches its target
+    UPROPERTY(BlueprintAssignable, Category = "RyRuntime|RotationInterpolator")
+    FRyOnRotationAtTarget OnInterpolatorAtTarget;
+
+private:
+
+    // Where an interpolator's rotation goes
+    struct FOutput
+    {
+        int32 Handle;
+        TWeakObjectPtr<USceneComponent> Component;
+        ERyRotationAxis Axis;
+        bool WorldSpace;
+        FRyOnRotationUpdated OnUpdated;
+    };
+
+    // A component rotation to set once the update loop is done
+    struct FPendingWrite
+    {
+        TWeakObjectPtr<USceneComponent> Component;
+        ERyRotationAxis Axis;
+        bool WorldSpace;
+        float Rotation;
+    };
+
+    int32 AddInterpolator(const float current, const float target, const float speed, FOutput&& output);
+    void RemoveInterpolatorAt(const int32 index);
+    static void WriteOutput(const FPendingWrite& pendingWrite);
+
+    // Structure of arrays, all aligned
+    TArray<float> Currents;
+    TArray<float> Targets;
+    TArray<float> Speeds;
+    TArray<bool> AtTargets;
+    TArray<FOutput> Outputs;
+
+    // Interpolator handle to index in the arrays
+    TMap<int32, int32> HandleToIndex;
+
+    // Per update scratch, kept to avoid reallocating every frame
+    TArray<bool> PreviousAtTargets;
+    TArray<FPendingWrite> PendingWrites;
+    TArray<TPair<int32, float>> PendingCallbacks;
+    TArray<TPair<int32, float>> PendingArrivals;
+    TArray<int32> DeadHandles;
+
+    int32 NextHandle = 0;
+    float CheckTolerance = 1.e-6f;
+};
@@ -0,0 +1,112 @@
+// Copyright 2020-2021 Sheffer Online Services.
+// MIT License. See LICENSE for details.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Components/SceneComponent.h"
+#include "RyRuntimeSpatialHashSubsystem.generated.h"
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+  * A world subsystem which keeps registered actors in a uniform spatial hash (a grid of cells keyed by cell coordinate).
+  * Registered actors are re-hashed as their root component moves, so radius and box queries only need to visit the
+  * cells overlapping the query instead of every actor in the world.
+  * Profile with "stat RyRuntime".
+*/
+UCLASS()
+class RYRUNTIME_API URyRuntimeSpatialHashSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+public:
+
+    /** USubsystem implementation */
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    // Set the size of a hash cell in world units. Changing the cell size re-hashes every registered actor.
+    // A good cell size is around the radius of your most common queries.
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|SpatialHash")
+    void SetCellSize(const float newCellSize);
+
+    // Get the size of a hash cell in world units
+    UFUNCTION(BlueprintPure, Category = "RyRuntime|SpatialHash")
+    float GetCellSize() const { return CellSize; }
+
+    // Register an actor with the spatial hash. The actor will be tracked until unregistered or it ends play (destroyed,
+    // or its level streamed out).
+    // Returns false if the actor is invalid, has no root component, or is already registered.
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|SpatialHash")
+    bool RegisterActor(AActor* actor);
+
+    // Register every actor of actorClass currently in the world. Returns the number of newly registered actors.
+    // This is a slow operation, use with caution e.g. do not use every frame.
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|SpatialHash")
+    int32 RegisterActorsOfClass(TSubclassOf<AActor> actorClass);
+
+    // Remove an actor from the spatial hash. Returns false if the actor wasn't registered.
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|SpatialHash")
+    bool UnregisterActor(AActor* actor);
+
+    // Remove all actors from the spatial hash
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|SpatialHash")
+    void UnregisterAllActors();
+
+    // Returns true if the actor is registered with the spatial hash
+    UFUNCTION(BlueprintPure, Category = "RyRuntime|SpatialHash")
+    bool IsActorRegistered(const AActor* actor) const;
+
+    // Returns the number of actors registered with the spatial hash
+    UFUNCTION(BlueprintPure, Category = "RyRuntime|SpatialHash")
+    int32 GetNumRegisteredActors() const { return Entries.Num(); }
+
+    // Gets all registered actors (optionally of actorClass) whose location is within radius of location
+    // @param actorClass - (Optional) Only actors of this class are returned. None returns all registered actors.
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|SpatialHash")
+    void QueryActorsInRadius(const FVector& location, const float radius, TSubclassOf<AActor> actorClass, TArray<AActor*>& actorsOut) const;
+
+    // Gets all registered actors (optionally of actorClass) whose location is inside box
+    // @param actorClass - (Optional) Only actors of this class are returned. None returns all registered actors.
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|SpatialHash")
+    void QueryActorsInBox(const FBox& box, TSubclassOf<AActor> actorClass, TArray<AActor*>& actorsOut) const;
+
+    // Times QueryActorsInRadius against the naive GetAllActorsOfClass plus distance filter path.
+    // Both paths are run 'iterations' times and the average milliseconds per query is returned.
+    UFUNCTION(BlueprintCallable, Category = "RyRuntime|SpatialHash", meta = (DevelopmentOnly, AdvancedDisplay = "3"))
+    void BenchmarkRadiusQuery(const FVector& location, const float radius, TSubclassOf<AActor> actorClass,
+                              float& hashMilliseconds, float& naiveMilliseconds, const int32 iterations = 100) const;
+
+private:
+
+    // An actor reference and its location as of the last hash update
+    struct FCellItem
+    {
+        TWeakObjectPtr<AActor> Actor;
+        FVector Location;
+    };
+
+    // Book keeping for a registered actor
+    struct FEntry
+    {
+        FIntVector Cell;
+        TWeakObjectPtr<USceneComponent> RootComponent;
+        FDelegateHandle TransformUpdatedHandle;
+    };
+
+    FIntVector GetCell(const FVector& location) const;
+    void AddToCell(AActor* actor, const FIntVector& cell, const FVector& location);
+    void RemoveFromCell(const AActor* actor, const FIntVector& cell);
+    void UpdateActor(AActor* actor, const FVector& location);
+    void GatherInBounds(const FBox& bounds, TSubclassOf<AActor> actorClass, TFunctionRef<bool(const FVector&)> filter, TArray<AActor*>& actorsOut) const;
+
+    void OnRootComponentTransformUpdated(USceneComponent* updatedComponent, EUpdateTransformFlags updateTransformFlags, ETeleportType teleport);
+
+    UFUNCTION()
+    void OnRegisteredActorEndPlay(AActor* actor, EEndPlayReason::Type endPlayReason);
+
+    float CellSize = 1000.0f;
+    float InvCellSize = 1.0f / 1000.0f;
+
+    TMap<FIntVector, TArray<FCellItem>> Cells;
+    TMap<TWeakObjectPtr<AActor>, FEntry> Entries;
+};